@@ -0,0 +1,60 @@
+int nondet_int();
+
+int main()
+{
+  int a = nondet_int(), b = nondet_int(), c = nondet_int(), d = nondet_int();
+  int x = 0;
+
+  if (a > 0)
+  {
+    if (b > 0)
+      x += 1;
+    else
+      x += 2;
+  }
+  else
+  {
+    if (c > 0)
+      x += 3;
+    else
+      x += 4;
+  }
+
+  if (b > a)
+  {
+    if (c > b)
+      x += 10;
+    else if (d > c)
+      x += 20;
+    else
+      x += 30;
+  }
+  else
+    x += 40;
+
+  if (d > 0)
+  {
+    if (a == d)
+      x *= 2;
+  }
+  else if (c == d)
+    x -= 1;
+
+  int y = 0;
+  for (int i = 0; i < 5; i++)
+  {
+    if (nondet_int())
+    {
+      if (nondet_int())
+        y += 1;
+      else
+        y += 2;
+    }
+    else if (nondet_int())
+      y += 3;
+  }
+
+  assert(x >= 10 && x <= 88);
+  assert(y <= 15);
+  return 0;
+}
@@ -0,0 +1,15 @@
+int y;
+
+// Not recursive, so the entry state of f is joined without extrapolation
+// and x stays within [1, 2]
+void f(int x)
+{
+  y = x;
+}
+
+int main()
+{
+  f(1);
+  f(2);
+  __ESBMC_assert(y == 2, "Should be able to verify!");
+}
@@ -0,0 +1,30 @@
+int g = 0;
+
+void odd();
+
+// The cycle closes through the call from odd to even, which must be
+// extrapolated for the analysis to terminate
+void even()
+{
+  if (g >= 100000)
+    return;
+  g++;
+  odd();
+}
+
+void odd()
+{
+  if (g >= 100000)
+    return;
+  g++;
+  even();
+}
+
+int main()
+{
+  int i = 0;
+  while (i < 10)
+    i++;
+  even();
+  __ESBMC_assert(i == 10, "Should be able to verify!");
+}
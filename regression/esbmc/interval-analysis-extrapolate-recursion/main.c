@@ -0,0 +1,20 @@
+int g = 0;
+
+// The entry state of count grows with every recursive call, until it is
+// extrapolated on the call edge
+void count()
+{
+  if (g >= 100000)
+    return;
+  g++;
+  count();
+}
+
+int main()
+{
+  int i = 0;
+  while (i < 10)
+    i++;
+  count();
+  __ESBMC_assert(i == 10, "Should be able to verify!");
+}
@@ -0,0 +1,16 @@
+int inc(int x)
+{
+  return x + 1;
+}
+
+int main()
+{
+  int i = 0, n = 0;
+  while (i < 10)
+  {
+    i = inc(i);
+    if (i > 5)
+      n = 1;
+  }
+  __ESBMC_assert(i == 10 && n == 1, "Should be able to verify!");
+}
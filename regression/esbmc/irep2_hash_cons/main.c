@@ -0,0 +1,25 @@
+#include <assert.h>
+
+struct point
+{
+  int x, y;
+};
+
+int nondet_int();
+
+int main()
+{
+  struct point a = {1, 2}, b = {1, 2};
+  int n = nondet_int();
+  __ESBMC_assume(n > 0 && n < 4);
+
+  for (int i = 0; i < n; i++)
+  {
+    a.x += i;
+    b.x += i;
+  }
+
+  assert(a.x == b.x && a.y == b.y);
+  assert(a.x + a.y < 5);
+  return 0;
+}
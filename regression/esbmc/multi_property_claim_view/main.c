@@ -0,0 +1,18 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  int y = nondet_int();
+  __ESBMC_assume(x > 0 && x < 100);
+
+  assert(x > 0);
+  y = x + 1;
+  assert(y > x);
+  x = x * 2;
+  assert(x < 100);
+  assert(y != 0);
+  return 0;
+}
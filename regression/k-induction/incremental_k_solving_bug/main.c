@@ -0,0 +1,17 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = 0;
+  int n = nondet_int();
+  __ESBMC_assume(n > 0 && n < 20);
+
+  while (x < n)
+    x++;
+
+  // Only violated once the loop has been unwound 7 times
+  assert(x != 7);
+  return 0;
+}
@@ -0,0 +1,16 @@
+#include <assert.h>
+
+unsigned int nondet_uint();
+
+int main()
+{
+  unsigned int i = 0;
+  unsigned int n = nondet_uint();
+  __ESBMC_assume(n < 10);
+
+  while (i < n)
+    i++;
+
+  assert(i <= 10);
+  return 0;
+}
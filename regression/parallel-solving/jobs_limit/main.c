@@ -0,0 +1,19 @@
+#include <assert.h>
+extern int __VERIFIER_nondet_int(void);
+
+int main()
+{
+  int a[8];
+  for (int i = 0; i < 8; i++)
+    a[i] = __VERIFIER_nondet_int();
+
+  assert(a[0] == a[0]);
+  assert(a[1] + 1 != a[1]);
+  assert(a[2] * 0 == 0);
+  assert(a[3] - a[3] == 0);
+  assert(a[4] != 42);
+  assert((a[5] & 1) == 0 || (a[5] & 1) == 1);
+  assert(a[6] == a[6]);
+  assert((a[7] ^ a[7]) == 0);
+  return 0;
+}
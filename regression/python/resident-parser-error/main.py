@@ -0,0 +1,3 @@
+def test(:
+    x : int = 2
+    assert(x == 2)
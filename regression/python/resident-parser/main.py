@@ -0,0 +1,5 @@
+def test() -> None:
+    x : int = 2
+    assert(x == 2)
+
+test()
@@ -0,0 +1,12 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  int y = x * x + 1;
+  assert(y != 0);
+  assert(y != 5);
+  return 0;
+}
@@ -0,0 +1,15 @@
+#!/usr/bin/env python3
+# Stands in for an SMT-LIB solver whose process esbmc keeps between claims:
+# it answers sat to a check-sat with no assertion since the last (reset),
+# and unsat to any other, so every claim holds and esbmc has to reset the
+# process before handing it to the next claim.
+import sys
+
+asserted = False
+for line in sys.stdin:
+    if "(reset)" in line:
+        asserted = False
+    if "(assert " in line:
+        asserted = True
+    if "(check-sat)" in line:
+        print("unsat" if asserted else "sat", flush=True)
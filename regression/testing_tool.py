@@ -12,6 +12,7 @@ import xml.etree.ElementTree as ET
 import time
 import shlex
 import subprocess
+import tempfile
 
 if sys.platform.startswith("linux"):
     from resource import *
@@ -137,14 +138,18 @@ class Executor:
         cmd = test_case.generate_run_argument_list(*self.tool)
 
         try:
-            # use subprocess.run because we want to wait for the subprocess to finish
-            p = subprocess.run(
-                cmd,
-                stdout=PIPE,
-                stderr=PIPE,
-                timeout=self.timeout,
-                env=dict(os.environ, ESBMC_CONFIG_FILE=""),
-            )
+            # use subprocess.run because we want to wait for the subprocess to finish.
+            # Each run gets an empty working directory, so that what a test
+            # writes to relative paths does not depend on earlier runs
+            with tempfile.TemporaryDirectory(prefix="esbmc-test-") as cwd:
+                p = subprocess.run(
+                    cmd,
+                    stdout=PIPE,
+                    stderr=PIPE,
+                    timeout=self.timeout,
+                    cwd=cwd,
+                    env=dict(os.environ, ESBMC_CONFIG_FILE=""),
+                )
 
             # get the RSS (resident set size) of the subprocess that just terminated.
             # Save the output in a tmp.log and then use the command below
@@ -0,0 +1,12 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  int y = nondet_int();
+  if (x > 0 && y > 0)
+    assert(x * y != 42);
+  return 0;
+}
@@ -49,6 +49,13 @@ inline unsigned adjust_size(unsigned size)
   return size;
 }
 
+// Size of the digit vector to use for the given number of digits.
+inline unsigned storage_size(unsigned digits)
+{
+  return digits <= BigInt::inline_digits ? unsigned(BigInt::inline_digits)
+                                         : adjust_size(digits);
+}
+
 // Compare unsigned digit strings, returns -1/0/+1.
 inline int digit_cmp(onedig_t const *a, onedig_t const *b, unsigned n)
 {
@@ -271,9 +278,9 @@ digit_div(onedig_t *r, const onedig_t *y, unsigned yl, onedig_t *q, unsigned ql)
 // Newly allocate uninitialized space for specified number of digits.
 inline void BigInt::allocate(unsigned digits)
 {
-  size = adjust_size(digits);
+  size = storage_size(digits);
   length = 0;
-  digit = new onedig_t[size];
+  digit = storage();
 }
 
 // Used in assignment: When smaller than specified digits, allocate
@@ -282,10 +289,10 @@ inline void BigInt::reallocate(unsigned digits)
 {
   if (digits > size)
   {
-    if (size)
+    if (on_heap())
       delete[] digit;
-    size = adjust_size(digits);
-    digit = new onedig_t[size];
+    size = storage_size(digits);
+    digit = storage();
   }
 }
 
@@ -295,14 +302,14 @@ inline void BigInt::resize(unsigned digits)
   if (digits > size)
   {
     onedig_t *old_digit = digit;
-    unsigned old_size = size;
-    size = adjust_size(digits);
-    digit = new onedig_t[size];
+    bool old_on_heap = on_heap();
+    size = storage_size(digits);
+    digit = storage();
 
-    if (old_digit != nullptr)
+    if (old_digit != nullptr && old_digit != digit)
     {
       memcpy(digit, old_digit, length * sizeof(onedig_t));
-      if (old_size)
+      if (old_on_heap)
         delete[] old_digit;
     }
   }
@@ -365,7 +372,7 @@ void BigInt::assign(llong_t l)
 
 BigInt::~BigInt()
 {
-  if (size > 0)
+  if (on_heap())
   {
     memset(digit, 0, size * sizeof digit[0]); // Crypto-paranoia.
     delete[] digit;
@@ -378,53 +385,53 @@ BigInt::BigInt(onedig_t *dig, unsigned len, bool pos)
 }
 
 BigInt::BigInt()
-  : size(adjust_size(small)),
+  : size(inline_digits),
     length(0),
-    digit(new onedig_t[size]),
+    digit(inline_digit),
     positive(true)
 {
 }
 
 BigInt::BigInt(signed long int n)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_digits), length(0), digit(inline_digit)
 {
   assign(llong_t(n));
 }
 
 BigInt::BigInt(unsigned long int n)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_digits), length(0), digit(inline_digit)
 {
   assign(ullong_t(n));
 }
 
 BigInt::BigInt(int n)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_digits), length(0), digit(inline_digit)
 {
   assign(llong_t(n));
 }
 
 BigInt::BigInt(unsigned u)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_digits), length(0), digit(inline_digit)
 {
   assign(ullong_t(u));
 }
 
 BigInt::BigInt(llong_t l)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_digits), length(0), digit(inline_digit)
 {
   assign(l);
 }
 
 BigInt::BigInt(ullong_t ul)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_digits), length(0), digit(inline_digit)
 {
   assign(ul);
 }
 
 BigInt::BigInt(BigInt const &y)
-  : size(adjust_size(y.length)),
+  : size(storage_size(y.length)),
     length(y.length),
-    digit(new onedig_t[size]),
+    digit(storage()),
     positive(y.positive)
 {
   memcpy(digit, y.digit, length * sizeof(onedig_t));
@@ -436,9 +443,9 @@ BigInt::BigInt(BigInt &&y) : BigInt()
 }
 
 BigInt::BigInt(char const *s, onedig_t b)
-  : size(adjust_size(small)),
+  : size(inline_digits),
     length(0),
-    digit(new onedig_t[size]),
+    digit(inline_digit),
     positive(true)
 {
   scan(s, b);
@@ -814,10 +821,12 @@ void BigInt::mul(onedig_t const *dig, unsigned len, bool pos)
   }
   else
   {
-    // Get a new string of digits for the result.
-    unsigned old_size = size;
-    size = adjust_size(length + len);
-    onedig_t *r = new onedig_t[size];
+    // Get a new string of digits for the result. Short products are
+    // formed on the stack and copied back, so that they stay inline.
+    unsigned n = length + len;
+    unsigned r_size = storage_size(n);
+    onedig_t short_r[inline_digits];
+    onedig_t *r = r_size == inline_digits ? short_r : new onedig_t[r_size];
 
     // The first parameter pair defines the outer loop which should
     // be the shorter.
@@ -827,10 +836,19 @@ void BigInt::mul(onedig_t const *dig, unsigned len, bool pos)
       digit_mul(dig, len, digit, length, r);
 
     // Replace digit string of this with result.
-    if (old_size)
-      delete[] digit;
-    digit = r;
-    length += len;
+    if (r == short_r)
+    {
+      reallocate(n);
+      memcpy(digit, r, n * sizeof(onedig_t));
+    }
+    else
+    {
+      if (on_heap())
+        delete[] digit;
+      size = r_size;
+      digit = r;
+    }
+    length = n;
     adjust();
   }
 
@@ -100,11 +100,33 @@ public:
     small = sizeof(ullong_t) / sizeof(onedig_t)
   };
 
+  // Number of digits kept inside the object itself. Numbers this short,
+  // which is almost every constant in a program, never touch the heap; this
+  // leaves room for the carry of adding and for the product of multiplying
+  // two numbers of up to `small` digits.
+  enum
+  {
+    inline_digits = 2 * small
+  };
+
 private:
   unsigned size;   // Length of digit vector.
   unsigned length; // Used places in digit vector.
   onedig_t *digit; // Least significant first.
   bool positive;   // Signed magnitude representation.
+  onedig_t inline_digit[inline_digits]; // Storage while size==inline_digits.
+
+  // Whether digit is owned and was allocated by new[].
+  bool on_heap() const
+  {
+    return size > inline_digits;
+  }
+
+  // Digit vector for a fresh object of the given size.
+  onedig_t *storage()
+  {
+    return on_heap() ? new onedig_t[size] : inline_digit;
+  }
 
   // Create or resize this.
   inline void allocate(unsigned digits);
@@ -328,6 +350,13 @@ public:
     std::swap(other.length, length);
     std::swap(other.digit, digit);
     std::swap(other.positive, positive);
+
+    // Digits kept inline move with the buffer, not with the pointer.
+    std::swap(other.inline_digit, inline_digit);
+    if (digit == other.inline_digit)
+      digit = inline_digit;
+    if (other.digit == inline_digit)
+      other.digit = other.inline_digit;
   }
 
 private:
@@ -1,7 +1,7 @@
+#include <c2goto/cprover_library_index.h>
 #include <cstdlib>
 #include <fstream>
 #include <goto-programs/goto_convert_functions.h>
-#include <goto-programs/write_goto_binary.h>
 #include <langapi/language_ui.h>
 #include <langapi/mode.h>
 #include <util/cmdline.h>
@@ -69,8 +69,6 @@ public:
 
   int doit() override
   {
-    goto_functionst goto_functions;
-
     if (config.set(cmdline))
       return 1;
     config.options.cmdline(cmdline);
@@ -90,7 +88,8 @@ public:
     std::ofstream out(
       cmdline.getval("output"), std::ios::out | std::ios::binary);
 
-    if (write_goto_binary(out, context, goto_functions))
+    cprover_library_indext::write(out, context);
+    if (!out)
     {
       log_error("Failed to write C library to binary obj");
       return 1;
@@ -1,10 +1,10 @@
 #include <ac_config.h>
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <c2goto/cprover_library.h>
+#include <c2goto/cprover_library_index.h>
 #include <cstdlib>
 #include <fstream>
-#include <goto-programs/goto_binary_reader.h>
-#include <goto-programs/goto_functions.h>
 #include <util/c_link.h>
 #include <util/config.h>
 #include <util/language.h>
@@ -136,89 +136,12 @@ const static std::vector<std::string> python_c_models = {
 
 } // namespace
 
-static void generate_symbol_deps(
-  irep_idt name,
-  irept irep,
-  std::multimap<irep_idt, irep_idt> &deps)
-{
-  std::pair<irep_idt, irep_idt> type;
-
-  if (irep.id() == "symbol")
-  {
-    type = std::pair<irep_idt, irep_idt>(name, irep.identifier());
-    deps.insert(type);
-    return;
-  }
-
-  forall_irep (irep_it, irep.get_sub())
-  {
-    if (irep_it->id() == "symbol")
-    {
-      type = std::pair<irep_idt, irep_idt>(name, irep_it->identifier());
-      deps.insert(type);
-      generate_symbol_deps(name, *irep_it, deps);
-    }
-    else if (irep_it->id() == "argument")
-    {
-      type = std::pair<irep_idt, irep_idt>(name, irep_it->cmt_identifier());
-      deps.insert(type);
-    }
-    else
-    {
-      generate_symbol_deps(name, *irep_it, deps);
-    }
-  }
-
-  forall_named_irep (irep_it, irep.get_named_sub())
-  {
-    if (irep_it->second.id() == "symbol")
-    {
-      type = std::pair<irep_idt, irep_idt>(name, irep_it->second.identifier());
-      deps.insert(type);
-    }
-    else if (irep_it->second.id() == "argument")
-    {
-      type =
-        std::pair<irep_idt, irep_idt>(name, irep_it->second.cmt_identifier());
-      deps.insert(type);
-    }
-    else
-    {
-      generate_symbol_deps(name, irep_it->second, deps);
-    }
-  }
-}
-
-static void ingest_symbol(
-  irep_idt name,
-  std::multimap<irep_idt, irep_idt> &deps,
-  std::list<irep_idt> &to_include)
-{
-  std::pair<
-    std::multimap<irep_idt, irep_idt>::const_iterator,
-    std::multimap<irep_idt, irep_idt>::const_iterator>
-    range;
-  std::multimap<irep_idt, irep_idt>::const_iterator it;
-
-  range = deps.equal_range(name);
-  if (range.first == range.second)
-    return;
-
-  for (it = range.first; it != range.second; it++)
-    to_include.push_back(it->second);
-
-  deps.erase(name);
-}
-
 void add_cprover_library(contextt &context, const languaget *language)
 {
   if (config.ansi_c.lib == configt::ansi_ct::libt::LIB_NONE)
     return;
 
-  contextt new_ctx, store_ctx;
-  goto_functionst goto_functions;
-  std::multimap<irep_idt, irep_idt> symbol_deps;
-  std::list<irep_idt> to_include;
+  contextt store_ctx;
   const buffer *clib;
 
   switch (config.ansi_c.word_size)
@@ -246,64 +169,41 @@ void add_cprover_library(contextt &context, const languaget *language)
     abort();
   }
 
-  goto_binary_reader goto_reader;
-
-  if (language && language->id() == "python")
-    goto_reader.set_functions_to_read(python_c_models);
-
-  if (goto_reader.read_goto_binary_array(
-        clib->start, clib->size, new_ctx, goto_functions))
+  cprover_library_indext library;
+  if (library.open(clib->start, clib->size))
+  {
+    log_error("Malformed internal C library");
     abort();
+  }
 
-  new_ctx.foreach_operand([&symbol_deps](const symbolt &s) {
-    generate_symbol_deps(s.id, s.value, symbol_deps);
-    generate_symbol_deps(s.id, s.type, symbol_deps);
-  });
-
-  // Add two hacks; we might use either pthread_mutex_lock or the checked
-  // variant; so if one version is used, pull in the other too.
-  std::pair<irep_idt, irep_idt> lockcheck(
-    dstring("pthread_mutex_lock"), dstring("pthread_mutex_lock_check"));
-  symbol_deps.insert(lockcheck);
-
-  std::pair<irep_idt, irep_idt> condcheck(
-    dstring("pthread_cond_wait"), dstring("pthread_cond_wait_check"));
-  symbol_deps.insert(condcheck);
-
-  std::pair<irep_idt, irep_idt> joincheck(
-    dstring("pthread_join"), dstring("pthread_join_noswitch"));
-  symbol_deps.insert(joincheck);
-
-  /* The code just pulled into store_ctx might use other symbols in the C
-   * library. So, repeatedly search for new C library symbols that we use but
-   * haven't pulled in, then pull them in. We finish when we've made a pass
-   * that adds no new symbols. */
-
-  new_ctx.foreach_operand(
-    [&context, &store_ctx, &symbol_deps, &to_include, &language](
-      const symbolt &s) {
-      const symbolt *symbol = context.find_symbol(s.id);
-      if (
-        (language && language->id() == "python") ||
-        (symbol != nullptr && symbol->value.is_nil()))
-      {
-        store_ctx.add(s);
-        ingest_symbol(s.id, symbol_deps, to_include);
-      }
-    });
-
-  for (std::list<irep_idt>::const_iterator nameit = to_include.begin();
-       nameit != to_include.end();
-       nameit++)
+  /* Only the index has been read so far. Pick the models the program
+   * declares but does not define, or, for Python, the fixed set of models
+   * its frontend relies on. */
+  const bool python = language && language->id() == "python";
+  std::vector<size_t> roots;
+  for (size_t i = 0; i < library.size(); i++)
   {
-    symbolt *s = new_ctx.find_symbol(*nameit);
-    if (s != nullptr)
+    if (python)
     {
-      store_ctx.add(*s);
-      ingest_symbol(*nameit, symbol_deps, to_include);
+      const std::string &function = library.function_name(i).as_string();
+      if (
+        std::find(python_c_models.begin(), python_c_models.end(), function) !=
+        python_c_models.end())
+        roots.push_back(i);
+      continue;
     }
+
+    const symbolt *symbol = context.find_symbol(library.id(i));
+    if (symbol != nullptr && symbol->value.is_nil())
+      roots.push_back(i);
   }
 
+  /* The models pulled in might use other symbols in the C library, which were
+   * recorded in the index when the library was built; decode all of them, and
+   * nothing else. The Python models are self-contained. */
+  for (size_t i : python ? roots : library.closure(roots))
+    store_ctx.add(library.read_symbol(i));
+
   if (c_link(context, store_ctx, "<built-in-library>"))
   {
     // Merging failed
@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <c2goto/cprover_library_index.h>
+#include <map>
+#include <sstream>
+#include <util/irep_serialization.h>
+#include <util/symbol_serialization.h>
+
+#define LIBRARY_INDEX_VERSION 1
+
+static void generate_symbol_deps(
+  irep_idt name,
+  irept irep,
+  std::multimap<irep_idt, irep_idt> &deps)
+{
+  std::pair<irep_idt, irep_idt> type;
+
+  if (irep.id() == "symbol")
+  {
+    type = std::pair<irep_idt, irep_idt>(name, irep.identifier());
+    deps.insert(type);
+    return;
+  }
+
+  forall_irep (irep_it, irep.get_sub())
+  {
+    if (irep_it->id() == "symbol")
+    {
+      type = std::pair<irep_idt, irep_idt>(name, irep_it->identifier());
+      deps.insert(type);
+      generate_symbol_deps(name, *irep_it, deps);
+    }
+    else if (irep_it->id() == "argument")
+    {
+      type = std::pair<irep_idt, irep_idt>(name, irep_it->cmt_identifier());
+      deps.insert(type);
+    }
+    else
+    {
+      generate_symbol_deps(name, *irep_it, deps);
+    }
+  }
+
+  forall_named_irep (irep_it, irep.get_named_sub())
+  {
+    if (irep_it->second.id() == "symbol")
+    {
+      type = std::pair<irep_idt, irep_idt>(name, irep_it->second.identifier());
+      deps.insert(type);
+    }
+    else if (irep_it->second.id() == "argument")
+    {
+      type =
+        std::pair<irep_idt, irep_idt>(name, irep_it->second.cmt_identifier());
+      deps.insert(type);
+    }
+    else
+    {
+      generate_symbol_deps(name, irep_it->second, deps);
+    }
+  }
+}
+
+void cprover_library_indext::write(std::ostream &out, const contextt &context)
+{
+  std::vector<const symbolt *> symbols;
+  std::unordered_map<irep_idt, size_t, irep_id_hash> index;
+  std::multimap<irep_idt, irep_idt> symbol_deps;
+
+  context.foreach_operand([&](const symbolt &s) {
+    index.emplace(s.id, symbols.size());
+    symbols.push_back(&s);
+    generate_symbol_deps(s.id, s.value, symbol_deps);
+    generate_symbol_deps(s.id, s.type, symbol_deps);
+  });
+
+  // Add two hacks; we might use either pthread_mutex_lock or the checked
+  // variant; so if one version is used, pull in the other too.
+  symbol_deps.emplace(
+    dstring("pthread_mutex_lock"), dstring("pthread_mutex_lock_check"));
+  symbol_deps.emplace(
+    dstring("pthread_cond_wait"), dstring("pthread_cond_wait_check"));
+  symbol_deps.emplace(
+    dstring("pthread_join"), dstring("pthread_join_noswitch"));
+
+  // Every record gets its own serialization tables, so that it can be
+  // decoded on its own
+  std::ostringstream records;
+  std::vector<std::pair<size_t, size_t>> extents;
+  for (const symbolt *s : symbols)
+  {
+    size_t start = records.tellp();
+    irep_serializationt::ireps_containert ic;
+    symbol_serializationt converter(ic);
+    converter.convert(*s, records);
+    extents.emplace_back(start, size_t(records.tellp()) - start);
+  }
+
+  out << "GBL";
+  write_long(out, LIBRARY_INDEX_VERSION);
+  write_long(out, symbols.size());
+  for (size_t i = 0; i < symbols.size(); i++)
+  {
+    const symbolt &s = *symbols[i];
+    write_string(out, s.id.as_string());
+    write_string(out, s.get_function_name().as_string());
+    write_long(out, extents[i].first);
+    write_long(out, extents[i].second);
+
+    // Only the symbols of the library itself are worth recording
+    std::vector<size_t> deps;
+    auto [begin, end] = symbol_deps.equal_range(s.id);
+    for (auto it = begin; it != end; it++)
+    {
+      auto dep = index.find(it->second);
+      if (
+        dep != index.end() && dep->second != i &&
+        std::find(deps.begin(), deps.end(), dep->second) == deps.end())
+        deps.push_back(dep->second);
+    }
+
+    write_long(out, deps.size());
+    for (size_t dep : deps)
+      write_long(out, dep);
+  }
+
+  out << records.str();
+}
+
+bool cprover_library_indext::open(const uint8_t *data, size_t size)
+{
+  using namespace boost::iostreams;
+  stream<array_source> in(reinterpret_cast<const char *>(data), size);
+
+  if (in.get() != 'G' || in.get() != 'B' || in.get() != 'L')
+    return true;
+  if (irep_serializationt::read_long(in) != LIBRARY_INDEX_VERSION)
+    return true;
+
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt reader(ic);
+
+  entries.clear();
+  by_id.clear();
+  entries.resize(irep_serializationt::read_long(in));
+  by_id.reserve(entries.size());
+  for (size_t i = 0; i < entries.size() && in.good(); i++)
+  {
+    entryt &e = entries[i];
+    e.id = reader.read_string(in);
+    e.function = reader.read_string(in);
+    e.offset = irep_serializationt::read_long(in);
+    e.size = irep_serializationt::read_long(in);
+    e.deps.resize(irep_serializationt::read_long(in));
+    for (size_t &dep : e.deps)
+      dep = irep_serializationt::read_long(in);
+    by_id.emplace(e.id, i);
+  }
+
+  if (!in.good())
+    return true;
+
+  size_t header_size = in.tellg();
+  records = data + header_size;
+  records_size = size - header_size;
+
+  for (const entryt &e : entries)
+  {
+    if (e.offset + e.size > records_size)
+      return true;
+    for (size_t dep : e.deps)
+      if (dep >= entries.size())
+        return true;
+  }
+
+  return false;
+}
+
+size_t cprover_library_indext::find(const irep_idt &id) const
+{
+  auto it = by_id.find(id);
+  return it == by_id.end() ? size() : it->second;
+}
+
+std::vector<size_t>
+cprover_library_indext::closure(const std::vector<size_t> &roots) const
+{
+  std::vector<bool> seen(size(), false);
+  std::vector<size_t> result;
+
+  for (size_t root : roots)
+    if (!seen[root])
+    {
+      seen[root] = true;
+      result.push_back(root);
+    }
+
+  for (size_t next = 0; next < result.size(); next++)
+    for (size_t dep : entries[result[next]].deps)
+      if (!seen[dep])
+      {
+        seen[dep] = true;
+        result.push_back(dep);
+      }
+
+  return result;
+}
+
+symbolt cprover_library_indext::read_symbol(size_t i) const
+{
+  using namespace boost::iostreams;
+  const entryt &e = entries[i];
+  stream<array_source> in(
+    reinterpret_cast<const char *>(records + e.offset), e.size);
+
+  irep_serializationt::ireps_containert ic;
+  symbol_serializationt converter(ic);
+  irept t;
+  converter.convert(in, t);
+
+  symbolt symbol;
+  symbol.from_irep(t);
+  return symbol;
+}
@@ -0,0 +1,85 @@
+#ifndef CPROVER_ANSI_C_CPROVER_LIBRARY_INDEX_H
+#define CPROVER_ANSI_C_CPROVER_LIBRARY_INDEX_H
+
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <util/context.h>
+#include <vector>
+
+/**
+ * Symbol-indexed format of the internal C library.
+ *
+ * c2goto writes the operational models as one self-contained record per
+ * symbol, preceded by an index giving, for every symbol, its name, the
+ * function it belongs to, where its record lives and which other library
+ * symbols it refers to. Reading the index decodes no irept at all: the set of
+ * models a program needs is computed on the dependency graph of the index,
+ * and only those records are then decoded.
+ *
+ * Layout, with numbers written by write_long() and strings by
+ * write_string():
+ *
+ *   "GBL" version
+ *   count
+ *   count times: id function offset size ndeps dep_1 ... dep_ndeps
+ *   records
+ *
+ * Offsets are relative to the start of the records; dependencies are
+ * indices into the index.
+ */
+class cprover_library_indext
+{
+public:
+  /** Parses the index of the library held in `data`, which must outlive this
+   *  object.
+   *  @return true on error, false on success */
+  bool open(const uint8_t *data, size_t size);
+
+  size_t size() const
+  {
+    return entries.size();
+  }
+
+  const irep_idt &id(size_t i) const
+  {
+    return entries[i].id;
+  }
+
+  /** Name of the function the symbol belongs to, see
+   *  symbolt::get_function_name() */
+  const irep_idt &function_name(size_t i) const
+  {
+    return entries[i].function;
+  }
+
+  /** @return the index of symbol `id`, or size() if there is none */
+  size_t find(const irep_idt &id) const;
+
+  /** @return `roots` and every symbol they transitively depend on, each once,
+   *  in breadth-first order */
+  std::vector<size_t> closure(const std::vector<size_t> &roots) const;
+
+  /** Decodes the record of symbol `i` */
+  symbolt read_symbol(size_t i) const;
+
+  /** Writes all symbols of `context` in this format */
+  static void write(std::ostream &out, const contextt &context);
+
+protected:
+  struct entryt
+  {
+    irep_idt id;
+    irep_idt function;
+    size_t offset;
+    size_t size;
+    std::vector<size_t> deps;
+  };
+
+  const uint8_t *records = nullptr;
+  size_t records_size = 0;
+  std::vector<entryt> entries;
+  std::unordered_map<irep_idt, size_t, irep_id_hash> by_id;
+};
+
+#endif
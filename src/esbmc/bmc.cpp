@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <thread>
 #include <chrono>
+#include <condition_variable>
 
 #ifndef _WIN32
 #  include <unistd.h>
@@ -24,6 +25,7 @@
 #include <goto-symex/build_goto_trace.h>
 #include <goto-symex/goto_trace.h>
 #include <goto-symex/features.h>
+#include <goto-symex/result_cache.h>
 #include <goto-symex/xml_goto_trace.h>
 #include <langapi/language_util.h>
 #include <langapi/languages.h>
@@ -36,8 +38,11 @@
 #include <util/migrate.h>
 #include <util/show_symbol_table.h>
 #include <util/time_stopping.h>
+#include <util/trace_profile.h>
 #include <util/cache.h>
+#include <util/thread_pool.h>
 #include <atomic>
+#include <optional>
 #include <goto-symex/witnesses.h>
 
 std::unordered_set<std::string> goto_functionst::reached_claims;
@@ -181,10 +186,20 @@ void bmct::generate_smt_from_equation(
   log_status("Encoding remaining VCC(s) using {}", logic);
 
   fine_timet encode_start = current_time();
-  eq.convert(smt_conv);
+  trace_spant span("smt", "convert");
+  if (k_step_session && &smt_conv == k_step_session->solver.get())
+  {
+    k_step_session->converter.convert(eq);
+    log_status(
+      "Re-used the encoding of {} SSA steps from the previous k-step",
+      k_step_session->converter.reused_steps());
+  }
+  else
+    eq.convert(smt_conv);
   fine_timet encode_stop = current_time();
   log_status(
     "Encoding to solver time: {}s", time2string(encode_stop - encode_start));
+  trace_profilet::counter("live SMT ASTs", smt_conv.live_asts.size());
 }
 
 void bmct::keep_alive_function() const
@@ -204,21 +219,25 @@ void bmct::keep_alive_function() const
   }
 }
 
+void bmct::start_keep_alive() const
+{
+  if (!options.get_bool_option("enable-keep-alive"))
+    return;
+
+  keep_alive_running = true;
+  keep_alive_interval = atoi(options.get_option("keep-alive-interval").c_str());
+
+  if (keep_alive_interval <= 0)
+    keep_alive_interval = 60; // Default interval to 60 seconds
+
+  std::thread([this]() { keep_alive_function(); }).detach();
+}
+
 smt_convt::resultt bmct::run_decision_procedure(
   smt_convt &smt_conv,
   symex_target_equationt &eq) const
 {
-  if (options.get_bool_option("enable-keep-alive"))
-  {
-    keep_alive_running = true;
-    keep_alive_interval =
-      atoi(options.get_option("keep-alive-interval").c_str());
-
-    if (keep_alive_interval <= 0)
-      keep_alive_interval = 60; // Default interval to 60 seconds
-
-    std::thread([this]() { keep_alive_function(); }).detach();
-  }
+  start_keep_alive();
 
   generate_smt_from_equation(smt_conv, eq);
 
@@ -231,12 +250,30 @@ smt_convt::resultt bmct::run_decision_procedure(
       return smt_convt::P_SMTLIB;
   }
 
+  smt_convt::resultt dec_result = solve_encoded(smt_conv);
+  keep_alive_running = false;
+  return dec_result;
+}
+
+smt_convt::resultt bmct::solve_encoded(smt_convt &smt_conv) const
+{
   log_progress("Solving with solver {}", smt_conv.solver_text());
 
+  // The solver does not touch the shared program: let other runs go on
+  const bool release_frontend = frontend_lock && frontend_lock->owns_lock() &&
+                                frontend_owner == std::this_thread::get_id();
+  if (release_frontend)
+    frontend_lock->unlock();
+
   fine_timet sat_start = current_time();
-  smt_convt::resultt dec_result = smt_conv.dec_solve();
+  uint64_t trace_start = trace_profilet::enabled() ? trace_profilet::now() : 0;
+  smt_convt::resultt dec_result =
+    interrupted ? smt_convt::P_ERROR : smt_conv.dec_solve();
+  trace_profilet::span("smt", "solve", trace_start);
   fine_timet sat_stop = current_time();
-  keep_alive_running = false;
+
+  if (release_frontend)
+    frontend_lock->lock();
 
   // output runtime
   log_status(
@@ -340,11 +377,11 @@ void bmct::report_trace(
   case smt_convt::P_SATISFIABLE:
     if (!bs && show_cex)
     {
-      error_trace(*runtime_solver, eq);
+      error_trace(get_runtime_solver(), eq);
     }
     else if (!is && !fc)
     {
-      error_trace(*runtime_solver, eq);
+      error_trace(get_runtime_solver(), eq);
     }
     break;
 
@@ -359,12 +396,13 @@ void bmct::report_trace(
   we finish reasoning this claims, thereby converting it to SKIP
 */
 void bmct::clear_verified_claims_in_ssa(
-  symex_target_equationt &local_eq,
+  symex_claim_viewt &view,
   const claim_slicer &claim,
   const bool &is_goto_cov)
 {
-  for (auto &step : local_eq.SSA_steps)
+  for (size_t i = 0; i < view.size(); i++)
   {
+    const symex_target_equationt::SSA_stept &step = view.step(i);
     if (!step.is_assert())
       continue;
 
@@ -381,9 +419,7 @@ void bmct::clear_verified_claims_in_ssa(
       expr_match = (from_expr(ns, "", step.guard) == claim.claim_msg);
 
     if (loc_match && expr_match)
-    {
-      step.cond = step.cond = gen_true_expr();
-    }
+      view.set_cond(i, gen_true_expr());
   }
 }
 
@@ -864,18 +900,45 @@ void bmct::report_result(smt_convt::resultt &res)
 
 smt_convt::resultt bmct::start_bmc()
 {
+  std::unique_lock<std::mutex> lock;
+  if (frontend_mutex)
+  {
+    lock = std::unique_lock<std::mutex>(*frontend_mutex);
+    frontend_lock = &lock;
+    frontend_owner = std::this_thread::get_id();
+  }
+
   std::shared_ptr<symex_target_equationt> eq;
   smt_convt::resultt res = run(eq);
   if (!options.get_bool_option("multi-property"))
     // multi-property traces are output during the run(eq)
     report_trace(res, *eq);
   report_result(res);
+
+  frontend_lock = nullptr;
   return res;
 }
 
+void bmct::interrupt()
+{
+  interrupted = true;
+
+  std::lock_guard lock(solver_mutex);
+  if (k_step_session)
+    k_step_session->solver->interrupt();
+  else if (runtime_solver)
+    runtime_solver->interrupt();
+  for (smt_convt *solver : portfolio_solvers)
+    solver->interrupt();
+}
+
 smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
 {
   symex->options.set_option("unwind", options.get_option("unwind"));
+  // The encoding of the previous k-step is only re-used up to the first step
+  // that differs, so the nondet symbols must be numbered the same way again
+  if (k_step_session)
+    execution_statet::reset_dynamic_counter();
   symex->setup_for_new_explore();
 
   if (options.get_bool_option("schedule"))
@@ -893,10 +956,10 @@ smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
     if (res == smt_convt::P_SATISFIABLE)
     {
       if (config.options.get_bool_option("smt-model"))
-        runtime_solver->print_model();
+        get_runtime_solver().print_model();
 
       if (config.options.get_bool_option("bidirectional"))
-        bidirectional_search(*runtime_solver, *eq);
+        bidirectional_search(get_runtime_solver(), *eq);
     }
 
     if (res)
@@ -956,7 +1019,8 @@ void bmct::bidirectional_search(
         return;
 
       // Save the location of the failed assertion
-      frames = ssait.stack_trace;
+      if (ssait.stack_trace)
+        frames = *ssait.stack_trace;
       assert_loop_number = ssait.loop_number;
 
       // We are not interested in instructions before the failed assertion yet
@@ -1069,9 +1133,12 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
   fine_timet symex_start = current_time();
   try
   {
+    uint64_t trace_start =
+      trace_profilet::enabled() ? trace_profilet::now() : 0;
     goto_symext::symex_resultt solver_result =
       options.get_bool_option("schedule") ? symex->generate_schedule_formula()
                                           : symex->get_next_formula();
+    trace_profilet::span("symex", "symex", trace_start);
 
     fine_timet symex_stop = current_time();
 
@@ -1086,12 +1153,17 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
     if (options.get_bool_option("double-assign-check"))
       eq->check_for_duplicate_assigns();
 
+    trace_profilet::counter("SSA steps", eq->SSA_steps.size());
     BigInt ignored;
+    trace_start = trace_profilet::enabled() ? trace_profilet::now() : 0;
     for (auto &a : algorithms)
     {
       a->run(eq->SSA_steps);
       ignored += a->ignored();
     }
+    trace_profilet::span("symex", "slicing", trace_start);
+    trace_profilet::counter(
+      "SSA steps", eq->SSA_steps.size() - ignored.to_int64());
 
     if (
       options.get_bool_option("program-only") ||
@@ -1147,19 +1219,23 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
       return smt_convt::P_UNSATISFIABLE;
     }
 
-    if (!options.get_bool_option("smt-during-symex"))
+    if (!options.get_option("portfolio").empty() && !k_step_session)
+      return run_portfolio(eq);
+
+    if (!options.get_bool_option("smt-during-symex") && !k_step_session)
     {
-      runtime_solver =
-        std::unique_ptr<smt_convt>(create_solver("", ns, options));
+      std::unique_ptr<smt_convt> solver(create_solver("", ns, options));
+      std::lock_guard lock(solver_mutex);
+      runtime_solver = std::move(solver);
     }
 
     if (
       options.get_bool_option("multi-property") &&
       options.get_bool_option("base-case"))
       return multi_property_check(
-        *eq, solver_result.remaining_claims, *runtime_solver);
+        *eq, solver_result.remaining_claims, get_runtime_solver());
 
-    return run_decision_procedure(*runtime_solver, *eq);
+    return run_decision_procedure(get_runtime_solver(), *eq);
   }
 
   catch (std::string &error_str)
@@ -1181,6 +1257,155 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
   }
 }
 
+smt_convt::resultt
+bmct::run_portfolio(std::shared_ptr<symex_target_equationt> &eq)
+{
+  std::vector<std::string> names;
+  std::istringstream list(options.get_option("portfolio"));
+  for (std::string name; std::getline(list, name, ',');)
+    if (!name.empty())
+      names.push_back(name);
+
+  if (names.empty())
+  {
+    log_error("--portfolio needs at least one solver");
+    abort();
+  }
+
+  struct entrantt
+  {
+    std::unique_ptr<smt_convt> solver;
+    std::shared_ptr<symex_target_equationt> eq;
+    smt_convt::resultt result = smt_convt::P_ERROR;
+    bool finished = false;
+  };
+
+  // Encoding stores the solver's ASTs in the SSA steps, so every solver needs
+  // its own copy of the equation
+  std::vector<entrantt> entrants(names.size());
+  for (size_t i = 0; i < names.size(); i++)
+  {
+    entrants[i].solver.reset(create_solver(names[i], ns, options));
+    entrants[i].eq =
+      i == 0 ? eq : std::make_shared<symex_target_equationt>(*eq);
+  }
+
+  std::mutex race_mutex;
+  std::condition_variable race_cv;
+  size_t finished = 0;
+  entrantt *winner = nullptr;
+
+  {
+    std::lock_guard lock(solver_mutex);
+    for (entrantt &e : entrants)
+      portfolio_solvers.push_back(e.solver.get());
+  }
+
+  // Encoding reads the symbol table and copies ireps: do it one solver at a
+  // time, under the frontend mutex when other runs share the program
+  std::mutex local_encode_mutex;
+  std::mutex &encode_mutex =
+    frontend_mutex ? *frontend_mutex : local_encode_mutex;
+  const bool release_frontend = frontend_lock && frontend_lock->owns_lock() &&
+                                frontend_owner == std::this_thread::get_id();
+  if (release_frontend)
+    frontend_lock->unlock();
+
+  auto decided = [&]() {
+    std::lock_guard lock(race_mutex);
+    return winner != nullptr;
+  };
+
+  auto race = [&](entrantt &e) {
+    smt_convt::resultt res = smt_convt::P_ERROR;
+    try
+    {
+      bool encoded = false;
+      {
+        std::lock_guard lock(encode_mutex);
+        if (!interrupted && !decided())
+        {
+          generate_smt_from_equation(*e.solver, *e.eq);
+          encoded = true;
+        }
+      }
+      if (encoded && !decided())
+        res = solve_encoded(*e.solver);
+    }
+    catch (...)
+    {
+      res = smt_convt::P_ERROR;
+    }
+
+    std::lock_guard lock(race_mutex);
+    e.result = res;
+    e.finished = true;
+    finished++;
+    if (
+      !winner && (res == smt_convt::P_SATISFIABLE ||
+                  res == smt_convt::P_UNSATISFIABLE))
+    {
+      winner = &e;
+      for (entrantt &loser : entrants)
+        if (&loser != &e)
+          loser.solver->interrupt();
+    }
+    race_cv.notify_all();
+  };
+
+  log_progress("Solving with portfolio {}", options.get_option("portfolio"));
+  start_keep_alive();
+
+  std::vector<std::thread> threads;
+  for (entrantt &e : entrants)
+    threads.emplace_back(race, std::ref(e));
+
+  {
+    // A solver only notices an interrupt once dec_solve has started, so keep
+    // interrupting the losers until they are all done
+    std::unique_lock lock(race_mutex);
+    std::vector<bool> warned(entrants.size(), false);
+    while (finished < entrants.size())
+    {
+      race_cv.wait_for(lock, std::chrono::milliseconds(100));
+      if (!winner && !interrupted)
+        continue;
+
+      for (size_t i = 0; i < entrants.size(); i++)
+      {
+        entrantt &e = entrants[i];
+        if (e.finished || &e == winner)
+          continue;
+        if (!e.solver->interrupt() && !warned[i])
+        {
+          log_warning(
+            "{} cannot be interrupted; waiting for it to finish",
+            e.solver->solver_text());
+          warned[i] = true;
+        }
+      }
+    }
+  }
+
+  for (std::thread &t : threads)
+    t.join();
+  keep_alive_running = false;
+
+  if (release_frontend)
+    frontend_lock->lock();
+
+  std::lock_guard lock(solver_mutex);
+  portfolio_solvers.clear();
+
+  if (!winner)
+    return smt_convt::P_ERROR;
+
+  log_status("Portfolio answered by {}", winner->solver->solver_text());
+  eq = winner->eq;
+  runtime_solver = std::move(winner->solver);
+  return winner->result;
+}
+
 int bmct::ltl_run_thread(symex_target_equationt &equation) const
 {
   /* LTL checking - first check for whether we have a negative prefix, then
@@ -1201,7 +1426,7 @@ int bmct::ltl_run_thread(symex_target_equationt &equation) const
     for (auto &SSA_step : equation.SSA_steps)
       if (SSA_step.is_assert())
       {
-        if (SSA_step.comment != which)
+        if (SSA_step.comment.as_string() != which)
           SSA_step.type = goto_trace_stept::SKIP;
         else
           num_asserts++;
@@ -1223,7 +1448,7 @@ int bmct::ltl_run_thread(symex_target_equationt &equation) const
     for (auto &SSA_step : equation.SSA_steps)
       if (SSA_step.is_skip())
         for (const auto &[which2, _] : seq)
-          if (SSA_step.comment == which2)
+          if (SSA_step.comment.as_string() == which2)
           {
             SSA_step.type = goto_trace_stept::ASSERT;
             break;
@@ -1315,10 +1540,59 @@ smt_convt::resultt bmct::multi_property_check(
   // For color output
   bool is_color = options.get_bool_option("color");
 
-  // TODO: This is the place to check a cache
   for (size_t i = 1; i <= remaining_claims; i++)
     jobs.emplace(i);
 
+  // Claims proven in earlier runs, looked up by the digest of their sliced
+  // formula. Not used when only the formula is wanted.
+  std::unique_ptr<claim_result_cachet> claim_cache;
+  const std::string cache_dir = options.get_option("claim-cache-dir");
+  if (
+    !cache_dir.empty() && !options.get_bool_option("smt-formula-only") &&
+    !options.get_bool_option("smt-formula-too"))
+    claim_cache = std::make_unique<claim_result_cachet>(cache_dir);
+
+  // Estimate the cost of each claim by the number of SSA steps preceding its
+  // assertion, as this bounds the cone of influence handed to the solver.
+  // Claims are numbered the same way claim_slicer counts them.
+  std::vector<size_t> claim_cost;
+  // Index of the assert step of each claim
+  std::vector<size_t> claim_step;
+  for (size_t s = 0; s < eq.SSA_steps.size(); s++)
+  {
+    if (!eq.SSA_steps[s].is_assert())
+      continue;
+    claim_cost.push_back(s + 1);
+    claim_step.push_back(s);
+  }
+
+  // For multi-property-incremental: the assignments and assumptions common
+  // to all claims are encoded once, into a single solver. Each claim is
+  // then checked in its own context pushed on top of that encoding.
+  const bool is_incremental =
+    options.get_bool_option("multi-property-incremental");
+  std::unique_ptr<symex_target_equationt> shared_eq;
+  std::unique_ptr<smt_convt> shared_solver;
+  if (is_incremental)
+  {
+    shared_eq = std::make_unique<symex_target_equationt>(eq);
+    shared_solver =
+      std::unique_ptr<smt_convt>(create_solver("", ns, options));
+
+    fine_timet encode_start = current_time();
+    shared_eq->convert_without_assertions(*shared_solver);
+    fine_timet encode_stop = current_time();
+    log_status(
+      "Encoding shared by all claims: {}s",
+      time2string(encode_stop - encode_start));
+  }
+  const symex_target_equationt &claim_eq = is_incremental ? *shared_eq : eq;
+
+  // Every claim is sliced on the same steps: number their symbols once
+  std::optional<slice_indext> slice_index;
+  if (!is_incremental && !options.get_bool_option("no-slice"))
+    slice_index.emplace(claim_eq.SSA_steps, options);
+
   /* This is a JOB that will:
    * 1. Generate a solver instance for a specific claim (@parameter i)
    * 2. Solve the instance
@@ -1332,7 +1606,12 @@ smt_convt::resultt bmct::multi_property_check(
    * if final_result is set to SAT
    */
   auto job_function = [this,
-                       &eq,
+                       &claim_eq,
+                       &slice_index,
+                       &claim_step,
+                       &is_incremental,
+                       &shared_solver,
+                       &claim_cache,
                        &ce_counter,
                        &final_result,
                        &result_mutex,
@@ -1361,14 +1640,16 @@ smt_convt::resultt bmct::multi_property_check(
     if (is_fail_fast && fail_fast_cnt >= fail_fast_limit)
       return;
 
-    // Since this is just a copy, we probably don't need a lock
-    symex_target_equationt local_eq = eq;
+    // Every claim shares the steps of eq; slicing and rewriting only touch
+    // this view, and only the steps left after slicing are copied.
+    symex_claim_viewt view(claim_eq);
 
     // Set up the current claim and disable slice info output
     bool is_goto_cov =
       is_assert_cov || is_cond_cov || is_branch_cov || is_branch_func_cov;
     claim_slicer claim(i, false, is_goto_cov, ns);
-    claim.run(local_eq.SSA_steps);
+    claim.run(view);
+    trace_spant claim_span("claim", claim.claim_cstr);
 
     // Drop claims that verified to be failed
     // we use the "comment + location" to distinguish each claim
@@ -1396,7 +1677,7 @@ smt_convt::resultt bmct::multi_property_check(
 
     if (verified_claims.count(claim.claim_cstr))
     {
-      clear_verified_claims_in_ssa(local_eq, claim, is_goto_cov);
+      clear_verified_claims_in_ssa(view, claim, is_goto_cov);
       clear_verified_claims_in_goto(claim, is_goto_cov);
       is_verified = true;
     }
@@ -1408,23 +1689,34 @@ smt_convt::resultt bmct::multi_property_check(
       return;
     }
 
-    // Slice
-    if (!options.get_bool_option("no-slice"))
+    // Slice. The shared encoding already covers the cone of every claim.
+    if (!is_incremental && !options.get_bool_option("no-slice"))
     {
-      symex_slicet slicer(options);
-      slicer.run(local_eq.SSA_steps);
+      trace_spant span("symex", "slicing");
+      symex_slicet slicer(options, &*slice_index);
+      slicer.run(view);
     }
 
     if (options.get_bool_option("ssa-features-dump"))
     {
+      // The features are computed over every step, sliced or not
+      symex_target_equationt all_steps = view.materialise(true);
       ssa_features features;
-      features.run(local_eq.SSA_steps);
+      features.run(all_steps.SSA_steps);
     }
 
+    // The equation handed to the solver and used for the counterexample. In
+    // incremental mode it is only needed, and built, for the counterexample.
+    std::optional<symex_target_equationt> local_eq;
+    if (!is_incremental)
+      local_eq.emplace(view.materialise());
+
     // Initialize a solver
     smt_convt *solver_ptr = &runtime_solver;
     std::unique_ptr<smt_convt> new_solver;
-    if (!options.get_bool_option("smt-during-symex"))
+    if (is_incremental)
+      solver_ptr = shared_solver.get();
+    else if (!options.get_bool_option("smt-during-symex"))
     {
       new_solver = std::unique_ptr<smt_convt>(create_solver("", ns, options));
       solver_ptr = new_solver.get();
@@ -1439,12 +1731,52 @@ smt_convt::resultt bmct::multi_property_check(
       claim.claim_cstr,
       solver_ptr->solver_text());
 
+    // The same formula, encoded the same way by the same solver and version,
+    // gives the same result
+    std::string cache_key;
+    bool cache_hit = false;
+    if (claim_cache)
+    {
+      cache_key = claim_result_cachet::key(
+        view,
+        fmt::format(
+          "{}\n{}\n{}",
+          ESBMC_VERSION,
+          solver_ptr->solver_text(),
+          claim_result_cachet::encoding_options(options)));
+      cache_hit = claim_cache->holds(cache_key);
+    }
+
     // Save current instance with timing
     fine_timet solve_start = current_time();
-    smt_convt::resultt solver_result =
-      run_decision_procedure(*solver_ptr, local_eq);
+    smt_convt::resultt solver_result;
+    bool pushed = false;
+    if (cache_hit)
+    {
+      log_status("Claim '{}' holds in the claim cache", claim.claim_cstr);
+      solver_result = smt_convt::P_UNSATISFIABLE;
+    }
+    else if (!is_incremental)
+      solver_result = run_decision_procedure(*solver_ptr, *local_eq);
+    else if (is_true(view.step(claim_step[i - 1]).cond))
+      // Cleared as already verified, nothing left to check
+      solver_result = smt_convt::P_UNSATISFIABLE;
+    else
+    {
+      // Violate this claim only; the context is popped once the
+      // counterexample, if any, has been extracted.
+      solver_ptr->push_ctx();
+      pushed = true;
+      solver_ptr->assert_ast(
+        solver_ptr->invert_ast(claim_eq.SSA_steps[claim_step[i - 1]].cond_ast));
+      solver_result = solver_ptr->dec_solve();
+    }
     fine_timet solve_stop = current_time();
 
+    if (
+      claim_cache && !cache_hit && solver_result == smt_convt::P_UNSATISFIABLE)
+      claim_cache->store_holds(cache_key);
+
     // Show colored result after solving
     const std::string GREEN = is_color ? "\033[32m" : "";
     const std::string RED = is_color ? "\033[31m" : "";
@@ -1486,8 +1818,11 @@ smt_convt::resultt bmct::multi_property_check(
         !options.get_bool_option("compact-trace"))
         is_compact_trace = false;
 
+      if (!local_eq)
+        local_eq.emplace(view.materialise());
+
       goto_tracet goto_trace;
-      build_goto_trace(local_eq, *solver_ptr, goto_trace, is_compact_trace);
+      build_goto_trace(*local_eq, *solver_ptr, goto_trace, is_compact_trace);
 
       // Store claim signature
       if (is_assert_cov)
@@ -1524,7 +1859,7 @@ smt_convt::resultt bmct::multi_property_check(
         report_multi_property_trace(
           solver_result,
           solver_ptr,
-          local_eq,
+          *local_eq,
           previous_ce_counter,
           goto_trace,
           claim.claim_msg);
@@ -1542,7 +1877,7 @@ smt_convt::resultt bmct::multi_property_check(
       // whenever we find a property violation, we remove the claim
       if (!is_keep_verified && (bs || fc || is))
       {
-        clear_verified_claims_in_ssa(local_eq, claim, is_goto_cov);
+        clear_verified_claims_in_ssa(view, claim, is_goto_cov);
         clear_verified_claims_in_goto(claim, is_goto_cov);
       }
     }
@@ -1552,35 +1887,43 @@ smt_convt::resultt bmct::multi_property_check(
       // either forward condition or inductive step
       if (!is_keep_verified && !bs)
       {
-        clear_verified_claims_in_ssa(local_eq, claim, is_goto_cov);
+        clear_verified_claims_in_ssa(view, claim, is_goto_cov);
         clear_verified_claims_in_goto(claim, is_goto_cov);
       }
+
+    if (pushed)
+      solver_ptr->pop_ctx();
   };
 
   // PARALLEL
   if (options.get_bool_option("parallel-solving"))
   {
-    /* NOTE: I would love to use std::for_each here, but it is not giving
-       * the result I would expect. My guess is either compiler version
-       * or some magic flag that we are not using.
-       *
-       * Nevertheless, we can achieve the same results by just creating
-       * threads.
-       */
-
-    // TODO: Running everything in parallel might be a bad idea.
-    //       Should we also add a thread pool?
-    std::vector<std::thread> parallel_jobs;
-    for (const auto &i : jobs)
-      parallel_jobs.push_back(std::thread(job_function, i));
-
-    // Main driver
-    for (auto &t : parallel_jobs)
+    // Bound the number of claims in flight: each one holds its sliced copy
+    // of the equation and its own solver instance.
+    size_t num_workers = 0;
+    const std::string jobs_opt = options.get_option("parallel-solving-jobs");
+    if (!jobs_opt.empty())
     {
-      t.join();
+      int n = stoi(jobs_opt);
+      if (n <= 0)
+      {
+        log_error("the value of parallel-solving-jobs should be positive!");
+        abort();
+      }
+      num_workers = n;
     }
-    // We could remove joined jobs from the parallel_jobs vector.
-    // However, its probably not worth for small vectors.
+
+    thread_poolt pool(num_workers);
+    log_status(
+      "Solving {} claims with {} worker threads",
+      jobs.size(),
+      std::min(pool.get_num_workers(), jobs.size()));
+    for (const auto &i : jobs)
+      pool.submit(
+        [&job_function, i]() { job_function(i); },
+        i <= claim_cost.size() ? claim_cost[i - 1] : 0);
+
+    pool.run();
   }
   // SEQUENTIAL
   else
@@ -15,6 +15,28 @@
 #include <util/algorithms.h>
 #include <util/cmdline.h>
 #include <atomic>
+#include <mutex>
+#include <thread>
+
+/**
+ * Solver kept alive across the k-steps of one check (base case, forward
+ * condition or inductive step) with --incremental-k-solving, so that each
+ * step only encodes what differs from the previous one.
+ */
+class k_step_sessiont
+{
+public:
+  k_step_sessiont(const contextt &context, const optionst &options)
+    : ns(context),
+      solver(create_solver("", ns, options)),
+      converter(*solver)
+  {
+  }
+
+  namespacet ns;
+  std::unique_ptr<smt_convt> solver;
+  incremental_equation_convertert converter;
+};
 
 class bmct
 {
@@ -38,22 +60,71 @@ public:
   virtual smt_convt::resultt run(std::shared_ptr<symex_target_equationt> &eq);
   virtual ~bmct() = default;
 
+  /// Use `session`'s solver instead of creating a fresh one for this run
+  void set_k_step_session(k_step_sessiont *session)
+  {
+    k_step_session = session;
+  }
+
+  /**
+   * Serialises this run with other bmct objects working on the same program
+   * in other threads. `mutex` is held throughout start_bmc() except while
+   * the solver runs: symbolic execution, encoding and trace building update
+   * the shared symbol table and irept reference counts, which are not
+   * thread-safe.
+   */
+  void set_frontend_mutex(std::mutex *mutex)
+  {
+    frontend_mutex = mutex;
+  }
+
+  /// Makes the current or next run give up with P_ERROR, interrupting the
+  /// solver if it supports it. May be called from any thread.
+  void interrupt();
+
+  bool was_interrupted() const
+  {
+    return interrupted;
+  }
+
 protected:
   const contextt &context;
   namespacet ns;
 
   std::unique_ptr<smt_convt> runtime_solver;
+  k_step_sessiont *k_step_session = nullptr;
   std::unique_ptr<reachability_treet> symex;
   mutable std::atomic<bool> keep_alive_running;
   mutable std::atomic<int> keep_alive_interval;
 
+  std::mutex *frontend_mutex = nullptr;
+  /// Lock on frontend_mutex held by the thread running start_bmc()
+  std::unique_lock<std::mutex> *frontend_lock = nullptr;
+  std::thread::id frontend_owner;
+
+  std::atomic<bool> interrupted{false};
+  /// Guards runtime_solver and portfolio_solvers against interrupt() from
+  /// other threads
+  mutable std::mutex solver_mutex;
+  /// Solvers racing in run_portfolio(), owned by it
+  std::vector<smt_convt *> portfolio_solvers;
+
   virtual smt_convt::resultt
   run_decision_procedure(smt_convt &smt_conv, symex_target_equationt &eq) const;
+  /// Solves what has been encoded into smt_conv, timing it
+  smt_convt::resultt solve_encoded(smt_convt &smt_conv) const;
+
+  smt_convt &get_runtime_solver() const
+  {
+    return k_step_session ? *k_step_session->solver : *runtime_solver;
+  }
 
   virtual void show_program(const symex_target_equationt &eq);
   virtual void report_success();
   virtual void report_failure();
   virtual void keep_alive_function() const;
+  /// Starts reporting that the solver is still running, if asked to
+  void start_keep_alive() const;
 
   virtual void
   error_trace(smt_convt &smt_conv, const symex_target_equationt &eq);
@@ -74,6 +145,15 @@ protected:
 
   smt_convt::resultt run_thread(std::shared_ptr<symex_target_equationt> &eq);
 
+  /**
+   * Solves `eq` with each solver named in the --portfolio option at once,
+   * each in its own thread on its own copy of the equation. The first
+   * definitive answer wins and the other solvers are interrupted. The winner
+   * becomes runtime_solver and its copy replaces `eq`, so that a
+   * counterexample can be built from its model.
+   */
+  smt_convt::resultt run_portfolio(std::shared_ptr<symex_target_equationt> &eq);
+
   int ltl_run_thread(symex_target_equationt &equation) const;
 
   smt_convt::resultt multi_property_check(
@@ -89,7 +169,7 @@ protected:
 
   // for multi-property
   void clear_verified_claims_in_ssa(
-    symex_target_equationt &local_eq,
+    symex_claim_viewt &view,
     const claim_slicer &claim,
     const bool &is_goto_cov);
   void clear_verified_claims_in_goto(
@@ -18,6 +18,7 @@ extern "C"
 
 #include <esbmc/bmc.h>
 #include <esbmc/esbmc_parseoptions.h>
+#include <esbmc/k_induction_parallel.h>
 #include <cctype>
 #include <clang-c-frontend/clang_c_language.h>
 #include <util/config.h>
@@ -52,6 +53,7 @@ extern "C"
 #include <pointer-analysis/value_set_analysis.h>
 #include <util/symbol.h>
 #include <util/time_stopping.h>
+#include <util/trace_profile.h>
 #include <goto-programs/goto_cfg.h>
 
 #ifndef _WIN32
@@ -78,20 +80,6 @@ static std::string_view esbmc_version_string()
   return {buildidstring_buf, buildidstring_buf_size};
 }
 
-enum PROCESS_TYPE
-{
-  BASE_CASE,
-  FORWARD_CONDITION,
-  INDUCTIVE_STEP,
-  PARENT
-};
-
-struct resultt
-{
-  PROCESS_TYPE type;
-  uint64_t k;
-};
-
 #ifndef _WIN32
 void timeout_handler(int)
 {
@@ -486,6 +474,46 @@ void esbmc_parseoptionst::get_command_line_options(optionst &options)
     options.set_option("base-case", true);
   }
 
+  // Multi-property solves each claim separately and smt-during-symex already
+  // owns the solver, neither can share one solver across k-steps
+  if (
+    cmdline.isset("incremental-k-solving") &&
+    (options.get_bool_option("multi-property") ||
+     cmdline.isset("smt-during-symex")))
+  {
+    log_warning(
+      "--incremental-k-solving is not supported with --multi-property or "
+      "--smt-during-symex, ignoring it");
+    options.set_option("incremental-k-solving", false);
+  }
+
+  // One solver is shared by every claim: it cannot be used by several threads
+  // at once, and smt-during-symex already owns the solver
+  if (
+    cmdline.isset("multi-property-incremental") &&
+    (cmdline.isset("parallel-solving") || cmdline.isset("smt-during-symex")))
+  {
+    log_warning(
+      "--multi-property-incremental is not supported with --parallel-solving "
+      "or --smt-during-symex, ignoring it");
+    options.set_option("multi-property-incremental", false);
+  }
+
+  // The portfolio races whole formulas: it does not apply to claims solved one
+  // by one, to a solver fed during symex, or to a formula that is only dumped
+  if (
+    cmdline.isset("portfolio") &&
+    (options.get_bool_option("multi-property") ||
+     cmdline.isset("smt-during-symex") || cmdline.isset("smt-formula-only") ||
+     cmdline.isset("smt-formula-too")))
+  {
+    log_warning(
+      "--portfolio is not supported with --multi-property, --parallel-solving, "
+      "--smt-during-symex, --smt-formula-only or --smt-formula-too, ignoring "
+      "it");
+    options.set_option("portfolio", "");
+  }
+
   /* compatibility: --cvc maps to --cvc4 */
   if (cmdline.isset("cvc"))
     options.set_option("cvc4", true);
@@ -543,6 +571,13 @@ int esbmc_parseoptionst::doit()
   if (cmdline.isset("version"))
     return 0;
 
+  if (cmdline.isset("trace-profile"))
+    trace_profilet::start(cmdline.getval("trace-profile"));
+
+  // Unique expressions from here on, before any are built by the frontends
+  if (cmdline.isset("irep2-hash-cons"))
+    esbmct::hash_consing = true;
+
   // Unwinding of transition systems
   if (cmdline.isset("module") || cmdline.isset("gen-interface"))
   {
@@ -638,90 +673,27 @@ int esbmc_parseoptionst::doit()
   return do_bmc(bmc);
 }
 
-// This is the parallel version of k-induction algorithm.
-// This is an old implementation and should be revisited sometime in the
-// future.
+// This is the parallel version of k-induction algorithm: the base case,
+// forward condition and inductive step are checked concurrently, on threads
+// sharing the GOTO program (see k_induction_schedulert).
 int esbmc_parseoptionst::doit_k_induction_parallel()
 {
-#ifdef _WIN32
-  log_error("Windows does not support parallel kind");
-  abort();
-#else
-  // Pipes for communication between processes
-  int forward_pipe[2], backward_pipe[2];
-
-  // Process type
-  PROCESS_TYPE process_type = PARENT;
-
-  if (pipe(forward_pipe))
-  {
-    log_status("\nPipe Creation Failed, giving up.");
-    _exit(1);
-  }
-
-  if (pipe(backward_pipe))
-  {
-    log_status("\nPipe Creation Failed, giving up.");
-    _exit(1);
-  }
-
-  /* Set file descriptor non-blocking */
-  fcntl(
-    backward_pipe[0], F_SETFL, fcntl(backward_pipe[0], F_GETFL) | O_NONBLOCK);
-
-  pid_t children_pid[3];
-  short num_p = 0;
-
-  // We need to fork 3 times: one for each step
-  for (unsigned p = 0; p < 3; ++p)
-  {
-    pid_t pid = fork();
-
-    if (pid == -1)
-    {
-      log_status("\nFork Failed, giving up.");
-      _exit(1);
-    }
-
-    // Child process
-    if (!pid)
-    {
-      process_type = PROCESS_TYPE(p);
-      break;
-    }
-    // Parent process
+  optionst options;
+  get_command_line_options(options);
 
-    children_pid[p] = pid;
-    ++num_p;
-  }
+  // Generate goto functions and set claims
+  if (get_goto_program(options, goto_functions))
+    return 6;
 
-  if (process_type == PARENT && num_p != 3)
+  if (cmdline.isset("show-claims"))
   {
-    log_error("Child processes were not created sucessfully.");
-    abort();
+    const namespacet ns(context);
+    show_claims(ns, goto_functions);
+    return 0;
   }
 
-  optionst options;
-
-  if (process_type != PARENT)
-  {
-    // Get full set of options
-    get_command_line_options(options);
-
-    // Generate goto functions and set claims
-    if (get_goto_program(options, goto_functions))
-      return 6;
-
-    if (cmdline.isset("show-claims"))
-    {
-      const namespacet ns(context);
-      show_claims(ns, goto_functions);
-      return 0;
-    }
-
-    if (set_claims(goto_functions))
-      return 7;
-  }
+  if (set_claims(goto_functions))
+    return 7;
 
   // Get max number of iterations
   uint64_t max_k_step = cmdline.isset("unlimited-k-steps")
@@ -741,476 +713,28 @@ int esbmc_parseoptionst::doit_k_induction_parallel()
     abort();
   }
 
-  // All processes were created successfully
-  switch (process_type)
-  {
-  case PARENT:
-  {
-    // Communication to child processes
-    close(forward_pipe[1]);
-    close(backward_pipe[0]);
-
-    struct resultt a_result;
-    bool bc_finished = false, fc_finished = false, is_finished = false;
-    uint64_t bc_solution = max_k_step, fc_solution = max_k_step,
-             is_solution = max_k_step;
-
-    // Keep reading until we find an answer
-    while (!(bc_finished && fc_finished && is_finished))
-    {
-      // Perform read and interpret the number of bytes read
-      int read_size = read(forward_pipe[0], &a_result, sizeof(resultt));
-      if (read_size != sizeof(resultt))
-      {
-        if (read_size == 0)
-        {
-          // Client hung up; continue on, but don't interpret the result.
-          ;
-        }
-        else
-        {
-          // Invalid size read.
-          log_error("Short read communicating with kinduction children");
-          log_error("Size {}, expected {}", read_size, sizeof(resultt));
-          abort();
-        }
-      }
-
-      // Eventually the parent process will check if the child process is alive
-
-      // Check base case process
-      if (!bc_finished)
-      {
-        int status;
-        pid_t result = waitpid(children_pid[0], &status, WNOHANG);
-        if (result == 0)
-        {
-          // Child still alive
-        }
-        else if (result == -1)
-        {
-          // Error
-        }
-        else
-        {
-          log_warning("base case process crashed.");
-          bc_finished = fc_finished = is_finished = true;
-        }
-      }
-
-      // Check forward condition process
-      if (!fc_finished)
-      {
-        int status;
-        pid_t result = waitpid(children_pid[1], &status, WNOHANG);
-        if (result == 0)
-        {
-          // Child still alive
-        }
-        else if (result == -1)
-        {
-          // Error
-        }
-        else
-        {
-          log_warning("forward condition process crashed.");
-          fc_finished = bc_finished = is_finished = true;
-        }
-      }
-
-      // Check inductive step process
-      if (!is_finished)
-      {
-        int status;
-        pid_t result = waitpid(children_pid[2], &status, WNOHANG);
-        if (result == 0)
-        {
-          // Child still alive
-        }
-        else if (result == -1)
-        {
-          // Error
-        }
-        else
-        {
-          log_warning("inductive step process crashed.");
-          is_finished = bc_finished = fc_finished = true;
-        }
-      }
-
-      switch (a_result.type)
-      {
-      case BASE_CASE:
-        bc_finished = true;
-        bc_solution = a_result.k;
-        break;
-
-      case FORWARD_CONDITION:
-        fc_finished = true;
-        fc_solution = a_result.k;
-        break;
-
-      case INDUCTIVE_STEP:
-        is_finished = true;
-        is_solution = a_result.k;
-        break;
-
-      default:
-        log_error("Message from unrecognized k-induction child process");
-        abort();
-      }
-
-      // If either the base case found a bug or the forward condition
-      // finds a solution, present the result
-      if (bc_finished && (bc_solution != 0) && (bc_solution != max_k_step))
-        break;
-
-      // If the either the forward condition or inductive step finds a
-      // solution, first check if base case couldn't find a bug in that code,
-      // if there is no bug, inductive step can present the result
-      if (fc_finished && (fc_solution != 0) && (fc_solution != max_k_step))
-      {
-        // If base case finished, then we can present the result
-        if (bc_finished)
-          break;
-
-        // Otherwise, kill the inductive step process
-        kill(children_pid[2], SIGKILL);
-
-        // And ask base case for a solution
-
-        // Struct to keep the result
-        struct resultt r = {process_type, 0};
-
-        r.k = fc_solution;
-
-        // Write result
-        auto const len = write(backward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-      }
-
-      if (is_finished && (is_solution != 0) && (is_solution != max_k_step))
-      {
-        // If base case finished, then we can present the result
-        if (bc_finished)
-          break;
-
-        // Otherwise, kill the forward condition process
-        kill(children_pid[1], SIGKILL);
-
-        // And ask base case for a solution
-
-        // Struct to keep the result
-        struct resultt r = {process_type, 0};
-
-        r.k = is_solution;
-
-        // Write result
-        auto const len = write(backward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-      }
-    }
-
-    for (int i : children_pid)
-      kill(i, SIGKILL);
-
-    // Check if a solution was found by the base case
-    if (bc_finished && (bc_solution != 0) && (bc_solution != max_k_step))
-    {
-      log_result(
-        "\nBug found by the base case (k = {})\nVERIFICATION FAILED",
-        bc_solution);
-      return true;
-    }
-
-    // Check if a solution was found by the forward condition
-    if (fc_finished && (fc_solution != 0) && (fc_solution != max_k_step))
-    {
-      // We should only present the result if the base case finished
-      // and haven't crashed (if it crashed, bc_solution will be UINT_MAX
-      if (bc_finished && (bc_solution != max_k_step))
-      {
-        log_success(
-          "\nSolution found by the forward condition; "
-          "all states are reachable (k = {:d})\n"
-          "VERIFICATION SUCCESSFUL",
-          fc_solution);
-        return false;
-      }
-    }
-
-    // Check if a solution was found by the inductive step
-    if (is_finished && (is_solution != 0) && (is_solution != max_k_step))
-    {
-      // We should only present the result if the base case finished
-      // and haven't crashed (if it crashed, bc_solution will be UINT_MAX
-      if (bc_finished && (bc_solution != max_k_step))
-      {
-        log_success(
-          "\nSolution found by the inductive step "
-          "(k = {:d})\n"
-          "VERIFICATION SUCCESSFUL",
-          is_solution);
-        return false;
-      }
-    }
-
-    // Couldn't find a bug or a proof for the current depth
-    log_fail("\nVERIFICATION UNKNOWN");
-    return false;
-  }
-
-  case BASE_CASE:
-  {
-    // Set that we are running base case
-    options.set_option("base-case", true);
-    options.set_option("forward-condition", false);
-    options.set_option("inductive-step", false);
-
-    options.set_option("no-unwinding-assertions", true);
-    options.set_option("partial-loops", false);
-
-    // Start communication to the parent process
-    close(forward_pipe[0]);
-    close(backward_pipe[1]);
-
-    // Struct to keep the result
-    struct resultt r = {process_type, 0};
-
-    // Run bmc and only send results in two occasions:
-    // 1. A bug was found, we send the step where it was found
-    // 2. It couldn't find a bug
-    for (uint64_t k_step = k_step_base; k_step <= max_k_step;
-         k_step += k_step_inc)
-    {
-      bmct bmc(goto_functions, options, context);
-      bmc.options.set_option("unwind", integer2string(k_step));
-
-      log_progress("Checking base case, k = {:d}\n", k_step);
-
-      // If an exception was thrown, we should abort the process
-      int res = smt_convt::P_ERROR;
-      try
-      {
-        res = do_bmc(bmc);
-      }
-      catch (...)
-      {
-        break;
-      }
-
-      // Send information to parent if no bug was found
-      if (res == smt_convt::P_SATISFIABLE)
-      {
-        r.k = k_step;
-
-        // Write result
-        auto const len = write(forward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-
-        log_status("Base case process finished (bug found).\n");
-        return true;
-      }
-
-      // Check if the parent process is asking questions
-
-      // Perform read and interpret the number of bytes read
-      struct resultt a_result;
-      int read_size = read(backward_pipe[0], &a_result, sizeof(resultt));
-      if (read_size != sizeof(resultt))
-      {
-        if (read_size == 0)
-        {
-          // Client hung up; continue on, but don't interpret the result.
-          continue;
-        }
-        if (read_size == -1 && errno == EAGAIN)
-        {
-          // No data available yet
-          continue;
-        }
-        else
-        {
-          // Invalid size read.
-          log_error("Short read communicating with kinduction parent");
-          log_error("Size {}, expected {}", read_size, sizeof(resultt));
-
-          abort();
-        }
-      }
-
-      // We only receive messages from the parent
-      assert(a_result.type == PARENT);
-
-      // If the value being asked is greater or equal the current step,
-      // then we can stop the base case. It can be equal, because we
-      // have just checked the current value of k
-      if (a_result.k < k_step)
-        break;
-
-      // Otherwise, we just need to check the base case for k = a_result.k
-      max_k_step = a_result.k + k_step_inc;
-    }
-
-    // Send information to parent that a bug was not found
-    r.k = 0;
-
-    auto const len = write(forward_pipe[1], &r, sizeof(r));
-    assert(len == sizeof(r) && "short write");
-    (void)len; //ndebug
-
-    log_status("Base case process finished (no bug found).\n");
-    return false;
-  }
-
-  case FORWARD_CONDITION:
-  {
-    // Set that we are running forward condition
-    options.set_option("base-case", false);
-    options.set_option("forward-condition", true);
-    options.set_option("inductive-step", false);
-
-    options.set_option("no-unwinding-assertions", false);
-    options.set_option("partial-loops", false);
-    options.set_option("no-assertions", true);
-
-    // Start communication to the parent process
-    close(forward_pipe[0]);
-    close(backward_pipe[1]);
-
-    // Struct to keep the result
-    struct resultt r = {process_type, 0};
-
-    // Run bmc and only send results in two occasions:
-    // 1. A proof was found, we send the step where it was found
-    // 2. It couldn't find a proof
-    for (uint64_t k_step = k_step_base + 1; k_step <= max_k_step;
-         k_step += k_step_inc)
-    {
-      bmct bmc(goto_functions, options, context);
-      bmc.options.set_option("unwind", integer2string(k_step));
-
-      log_status("Checking forward condition, k = {:d}", k_step);
-
-      // If an exception was thrown, we should abort the process
-      int res = smt_convt::P_ERROR;
-      try
-      {
-        res = do_bmc(bmc);
-      }
-      catch (...)
-      {
-        break;
-      }
-
-      if (options.get_bool_option("disable-forward-condition"))
-        break;
-
-      // Send information to parent if no bug was found
-      if (res == smt_convt::P_UNSATISFIABLE)
-      {
-        r.k = k_step;
-
-        // Write result
-        auto const len = write(forward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-
-        log_status("Forward condition process finished (safety proven).");
-        return false;
-      }
-    }
-
-    // Send information to parent that it couldn't prove the code
-    r.k = 0;
-
-    auto const len = write(forward_pipe[1], &r, sizeof(r));
-    assert(len == sizeof(r) && "short write");
-    (void)len; //ndebug
-
-    log_status("Forward condition process finished (safety not proven).");
-    return true;
-  }
-
-  case INDUCTIVE_STEP:
+  // One thread per step by default, more let several k run at once
+  int num_workers = 3;
+  const std::string jobs_opt = options.get_option("k-induction-parallel-jobs");
+  if (!jobs_opt.empty())
   {
-    // Set that we are running inductive step
-    options.set_option("base-case", false);
-    options.set_option("forward-condition", false);
-    options.set_option("inductive-step", true);
-
-    options.set_option("no-unwinding-assertions", true);
-    options.set_option("partial-loops", true);
-
-    // Start communication to the parent process
-    close(forward_pipe[0]);
-    close(backward_pipe[1]);
-
-    // Struct to keep the result
-    struct resultt r = {process_type, 0};
-
-    // Run bmc and only send results in two occasions:
-    // 1. A proof was found, we send the step where it was found
-    // 2. It couldn't find a proof
-    for (uint64_t k_step = k_step_base + 1; k_step <= max_k_step;
-         k_step += k_step_inc)
+    num_workers = stoi(jobs_opt);
+    if (num_workers <= 0)
     {
-      bmct bmc(goto_functions, options, context);
-
-      bmc.options.set_option("unwind", integer2string(k_step));
-
-      log_status("Checking inductive step, k = {:d}", k_step);
-
-      // If an exception was thrown, we should abort the process
-      int res = smt_convt::P_ERROR;
-      try
-      {
-        res = do_bmc(bmc);
-      }
-      catch (...)
-      {
-        break;
-      }
-
-      if (options.get_bool_option("disable-inductive-step"))
-        break;
-
-      // Send information to parent if no bug was found
-      if (res == smt_convt::P_UNSATISFIABLE)
-      {
-        r.k = k_step;
-
-        // Write result
-        auto const len = write(forward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-
-        log_status("Inductive process finished (safety proven).");
-        return false;
-      }
+      log_error("the value of k-induction-parallel-jobs should be positive!");
+      abort();
     }
-
-    // Send information to parent that it couldn't prove the code
-    r.k = 0;
-
-    auto const len = write(forward_pipe[1], &r, sizeof(r));
-    assert(len == sizeof(r) && "short write");
-    (void)len; //ndebug
-
-    log_status("Inductive process finished (safety not proven).");
-    return true;
   }
 
-  default:
-    assert(0 && "Unknown process type.");
-  }
-
-#endif
-
-  return 0;
+  k_induction_schedulert scheduler(
+    goto_functions,
+    context,
+    options,
+    k_step_base,
+    k_step_inc,
+    max_k_step,
+    num_workers);
+  return scheduler.run();
 }
 
 // This method iteratively applies one of the verification strategies
@@ -1377,6 +901,7 @@ tvt esbmc_parseoptionst::is_base_case_violated(
   options.set_option("unwind", integer2string(k_step));
 
   bmct bmc(goto_functions, options, context);
+  bmc.set_k_step_session(get_k_step_session(base_case_session, options));
 
   log_progress("Checking base case, k = {:d}", k_step);
   switch (do_bmc(bmc))
@@ -1436,6 +961,8 @@ tvt esbmc_parseoptionst::does_forward_condition_hold(
   options.set_option("unwind", integer2string(k_step));
 
   bmct bmc(goto_functions, options, context);
+  bmc.set_k_step_session(
+    get_k_step_session(forward_condition_session, options));
 
   log_progress("Checking forward condition, k = {:d}", k_step);
   auto res = do_bmc(bmc);
@@ -1501,6 +1028,7 @@ tvt esbmc_parseoptionst::is_inductive_step_violated(
   options.set_option("unwind", integer2string(k_step));
 
   bmct bmc(goto_functions, options, context);
+  bmc.set_k_step_session(get_k_step_session(inductive_step_session, options));
 
   log_progress("Checking inductive step, k = {:d}", k_step);
   switch (do_bmc(bmc))
@@ -1527,6 +1055,20 @@ tvt esbmc_parseoptionst::is_inductive_step_violated(
   return tvt(tvt::TV_UNKNOWN);
 }
 
+// Returns the solver session to be shared by all k-steps of one check, or
+// nullptr if every k-step should use a fresh solver.
+k_step_sessiont *esbmc_parseoptionst::get_k_step_session(
+  std::unique_ptr<k_step_sessiont> &session,
+  const optionst &options)
+{
+  if (!options.get_bool_option("incremental-k-solving"))
+    return nullptr;
+
+  if (!session)
+    session = std::make_unique<k_step_sessiont>(context, options);
+  return session.get();
+}
+
 // This is a wrapper method that does a single round of
 // symbolic execution of the given GOTO program and creates
 // a decision problem specified by the verification options.
@@ -1608,16 +1150,22 @@ bool esbmc_parseoptionst::get_goto_program(
   try
   {
     fine_timet create_start = current_time();
-    if (create_goto_program(options, goto_functions))
-      return true;
+    {
+      trace_spant span("frontend", "create GOTO program");
+      if (create_goto_program(options, goto_functions))
+        return true;
+    }
     fine_timet create_stop = current_time();
     log_status(
       "GOTO program creation time: {}s",
       time2string(create_stop - create_start));
 
     fine_timet process_start = current_time();
-    if (process_goto_program(options, goto_functions))
-      return true;
+    {
+      trace_spant span("goto", "process GOTO program");
+      if (process_goto_program(options, goto_functions))
+        return true;
+    }
     fine_timet process_stop = current_time();
     log_status(
       "GOTO program processing time: {}s",
@@ -1755,8 +1303,11 @@ bool esbmc_parseoptionst::parse_goto_program(
 {
   try
   {
-    if (parse(cmdline))
-      return true;
+    {
+      trace_spant span("frontend", "parse");
+      if (parse(cmdline))
+        return true;
+    }
 
     if (cmdline.isset("parse-tree-too") || cmdline.isset("parse-tree-only"))
     {
@@ -1769,10 +1320,13 @@ bool esbmc_parseoptionst::parse_goto_program(
     }
 
     // Typechecking (old frontend) or adjust (clang frontend)
-    if (typecheck())
-      return true;
-    if (final())
-      return true;
+    {
+      trace_spant span("frontend", "typecheck");
+      if (typecheck())
+        return true;
+      if (final())
+        return true;
+    }
 
     // we no longer need any parse trees or language files
     clear_parse();
@@ -1787,6 +1341,7 @@ bool esbmc_parseoptionst::parse_goto_program(
     }
 
     log_progress("Generating GOTO Program");
+    trace_spant span("frontend", "goto_convert");
     goto_convert(context, options, goto_functions);
   }
 
@@ -1864,7 +1419,10 @@ bool esbmc_parseoptionst::process_goto_program(
 
     // Start by removing all no-op instructions and unreachable code
     if (!(cmdline.isset("no-remove-no-op")))
+    {
+      trace_spant span("goto", "remove_no_op");
       remove_no_op(goto_functions);
+    }
 
     // We should skip this 'remove-unreachable' removal in goto-cov and multi-property
     // - multi-property wants to find all the bugs in the src code
@@ -1874,11 +1432,15 @@ bool esbmc_parseoptionst::process_goto_program(
       !(cmdline.isset("no-remove-unreachable") || is_mul || is_coverage) ||
       cmdline.isset("condition-coverage-rm") ||
       cmdline.isset("condition-coverage-claims-rm"))
+    {
+      trace_spant span("goto", "remove_unreachable");
       remove_unreachable(goto_functions);
+    }
 
     // Apply all the initialized algorithms
     for (auto &algorithm : goto_preprocess_algorithms)
     {
+      trace_spant span("goto", "preprocessing algorithm");
       if (cmdline.isset("function"))
         algorithm->setTarget(cmdline.getval("function"));
       algorithm->run(goto_functions);
@@ -1887,6 +1449,7 @@ bool esbmc_parseoptionst::process_goto_program(
     // do partial inlining
     if (!cmdline.isset("no-inlining"))
     {
+      trace_spant span("goto", "inlining");
       if (cmdline.isset("full-inlining"))
         goto_inline(goto_functions, options, ns);
       else
@@ -1895,6 +1458,7 @@ bool esbmc_parseoptionst::process_goto_program(
 
     if (cmdline.isset("gcse"))
     {
+      trace_spant span("goto", "gcse");
       std::shared_ptr<value_set_analysist> vsa =
         std::make_shared<value_set_analysist>(ns);
       try
@@ -1939,6 +1503,7 @@ bool esbmc_parseoptionst::process_goto_program(
 
     if (cmdline.isset("interval-analysis") || cmdline.isset("goto-contractor"))
     {
+      trace_spant span("goto", "interval_analysis");
       interval_analysis(goto_functions, ns, options);
     }
 
@@ -1948,6 +1513,7 @@ bool esbmc_parseoptionst::process_goto_program(
     {
       // Always remove skips before doing k-induction.
       // It seems to fix some issues for now
+      trace_spant span("goto", "goto_k_induction");
       remove_no_op(goto_functions);
       goto_k_induction(goto_functions);
     }
@@ -1967,20 +1533,26 @@ bool esbmc_parseoptionst::process_goto_program(
 #endif
     }
 
-    goto_check(ns, options, goto_functions);
+    {
+      trace_spant span("goto", "goto_check");
+      goto_check(ns, options, goto_functions);
+    }
 
     // add re-evaluations of monitored properties
     add_property_monitors(goto_functions, ns);
 
     // Once again, remove all unreachable and no-op code that could have been
     // introduced by the above algorithms
-    if (!(cmdline.isset("no-remove-no-op")))
-      remove_no_op(goto_functions);
+    {
+      trace_spant span("goto", "cleanup");
+      if (!(cmdline.isset("no-remove-no-op")))
+        remove_no_op(goto_functions);
 
-    if (!(cmdline.isset("no-remove-unreachable") || is_mul || is_coverage))
-      remove_unreachable(goto_functions);
+      if (!(cmdline.isset("no-remove-unreachable") || is_mul || is_coverage))
+        remove_unreachable(goto_functions);
 
-    goto_functions.update();
+      goto_functions.update();
+    }
 
     if (cmdline.isset("data-races-check"))
     {
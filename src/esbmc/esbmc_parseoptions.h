@@ -66,6 +66,10 @@ protected:
     goto_functionst &goto_functions,
     const uint64_t &k_step);
 
+  k_step_sessiont *get_k_step_session(
+    std::unique_ptr<k_step_sessiont> &session,
+    const optionst &options);
+
   bool read_goto_binary(goto_functionst &goto_functions);
 
   bool set_claims(goto_functionst &goto_functions);
@@ -95,6 +99,11 @@ protected:
   // coverage mode
   bool is_coverage;
 
+  // solvers shared across k-steps by --incremental-k-solving
+  std::unique_ptr<k_step_sessiont> base_case_session;
+  std::unique_ptr<k_step_sessiont> forward_condition_session;
+  std::unique_ptr<k_step_sessiont> inductive_step_session;
+
 private:
   void close_file(FILE *f)
   {
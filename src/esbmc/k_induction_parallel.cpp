@@ -0,0 +1,271 @@
+#include <chrono>
+#include <esbmc/k_induction_parallel.h>
+#include <thread>
+#include <util/message.h>
+#include <util/mp_arith.h>
+
+k_induction_schedulert::k_induction_schedulert(
+  goto_functionst &goto_functions,
+  contextt &context,
+  const optionst &options,
+  uint64_t k_step_base,
+  uint64_t k_step_inc,
+  uint64_t max_k_step,
+  size_t num_workers)
+  : goto_functions(goto_functions),
+    context(context),
+    k_step_base(k_step_base),
+    k_step_inc(k_step_inc),
+    max_k_step(max_k_step),
+    num_workers(num_workers ? num_workers : 1),
+    bc_clean_up_to(k_step_base)
+{
+  for (auto &opts : step_options)
+    opts = options;
+
+  optionst &bc = step_options[BASE_CASE];
+  bc.set_option("base-case", true);
+  bc.set_option("forward-condition", false);
+  bc.set_option("inductive-step", false);
+  bc.set_option("no-unwinding-assertions", true);
+  bc.set_option("partial-loops", false);
+
+  optionst &fc = step_options[FORWARD_CONDITION];
+  fc.set_option("base-case", false);
+  fc.set_option("forward-condition", true);
+  fc.set_option("inductive-step", false);
+  fc.set_option("no-unwinding-assertions", false);
+  fc.set_option("partial-loops", false);
+  fc.set_option("no-assertions", true);
+
+  optionst &is = step_options[INDUCTIVE_STEP];
+  is.set_option("base-case", false);
+  is.set_option("forward-condition", false);
+  is.set_option("inductive-step", true);
+  is.set_option("no-unwinding-assertions", true);
+  is.set_option("partial-loops", true);
+
+  next_k[BASE_CASE] = k_step_base;
+  next_k[FORWARD_CONDITION] = k_step_base + 1;
+  next_k[INDUCTIVE_STEP] = k_step_base + 1;
+
+  enabled[BASE_CASE] = true;
+  enabled[FORWARD_CONDITION] =
+    !options.get_bool_option("disable-forward-condition");
+  enabled[INDUCTIVE_STEP] = !options.get_bool_option("disable-inductive-step");
+}
+
+const char *k_induction_schedulert::step_name(stept step)
+{
+  switch (step)
+  {
+  case BASE_CASE:
+    return "base case";
+  case FORWARD_CONDITION:
+    return "forward condition";
+  case INDUCTIVE_STEP:
+    return "inductive step";
+  default:
+    return "unknown step";
+  }
+}
+
+bool k_induction_schedulert::is_needed(stept step, uint64_t k) const
+{
+  if (decided || !enabled[step] || k > max_k_step)
+    return false;
+
+  // Once a proof is found, the base case only has to rule out bugs up to it
+  if (step == BASE_CASE)
+    return !proof_k || k <= proof_k;
+
+  return !proof_k;
+}
+
+bool k_induction_schedulert::pick_task(stept &step, uint64_t &k) const
+{
+  bool found = false;
+  for (int s = 0; s < NUM_STEPS; s++)
+  {
+    stept candidate = stept(s);
+    if (!is_needed(candidate, next_k[candidate]))
+      continue;
+    if (found && next_k[candidate] >= k)
+      continue;
+
+    step = candidate;
+    k = next_k[candidate];
+    found = true;
+  }
+  return found;
+}
+
+void k_induction_schedulert::record_result(
+  stept step,
+  uint64_t k,
+  smt_convt::resultt res)
+{
+  if (res == smt_convt::P_ERROR)
+  {
+    log_warning("{} crashed (k = {:d})", step_name(step), k);
+    error = true;
+  }
+  else if (step == BASE_CASE)
+  {
+    if (res == smt_convt::P_SATISFIABLE)
+      bug_k = bug_k ? std::min(bug_k, k) : k;
+    else if (res == smt_convt::P_UNSATISFIABLE)
+    {
+      bc_clean.insert(k);
+      while (bc_clean.erase(bc_clean_up_to))
+        bc_clean_up_to += k_step_inc;
+    }
+  }
+  else if (res == smt_convt::P_UNSATISFIABLE)
+  {
+    if (!proof_k || k < proof_k)
+    {
+      proof_k = k;
+      proof_step = step;
+    }
+  }
+
+  if (bug_k || error || (proof_k && bc_clean_up_to > proof_k))
+    decided = true;
+}
+
+void k_induction_schedulert::interrupt_unneeded()
+{
+  for (taskt *task : running)
+    if (task->bmc && !is_needed(task->step, task->k))
+      task->bmc->interrupt();
+}
+
+void k_induction_schedulert::worker()
+{
+  std::unique_lock lock(state_mutex);
+  while (!decided)
+  {
+    stept step;
+    uint64_t k;
+    if (!pick_task(step, k))
+    {
+      // Nothing left to schedule: wait for the results still coming, or
+      // stop if there are none
+      if (running.empty())
+      {
+        decided = true;
+        break;
+      }
+      state_changed.wait(lock);
+      continue;
+    }
+
+    next_k[step] += k_step_inc;
+    taskt task = {step, k, nullptr};
+    running.push_back(&task);
+    lock.unlock();
+
+    log_status("Checking {}, k = {:d}", step_name(step), k);
+
+    optionst options = step_options[step];
+    options.set_option("unwind", integer2string(k));
+    std::unique_ptr<bmct> bmc;
+    {
+      std::lock_guard frontend(frontend_mutex);
+      bmc = std::make_unique<bmct>(goto_functions, options, context);
+    }
+    bmc->set_frontend_mutex(&frontend_mutex);
+
+    lock.lock();
+    task.bmc = bmc.get();
+    const bool needed = is_needed(step, k);
+    lock.unlock();
+
+    smt_convt::resultt res = smt_convt::P_ERROR;
+    if (needed)
+    {
+      try
+      {
+        res = bmc->start_bmc();
+      }
+      catch (...)
+      {
+        res = smt_convt::P_ERROR;
+      }
+    }
+
+    lock.lock();
+    running.remove(&task);
+    if (needed && !bmc->was_interrupted())
+      record_result(step, k, res);
+    interrupt_unneeded();
+    state_changed.notify_all();
+    lock.unlock();
+
+    {
+      std::lock_guard frontend(frontend_mutex);
+      bmc.reset();
+    }
+    lock.lock();
+  }
+
+  --active_workers;
+  state_changed.notify_all();
+}
+
+bool k_induction_schedulert::run()
+{
+  active_workers = num_workers;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_workers; i++)
+    threads.emplace_back(&k_induction_schedulert::worker, this);
+
+  {
+    std::unique_lock lock(state_mutex);
+    while (active_workers > 0)
+    {
+      // An interrupt that reaches a solver right before it starts is lost,
+      // so keep interrupting the runs that are no longer needed
+      state_changed.wait_for(lock, std::chrono::milliseconds(100));
+      interrupt_unneeded();
+    }
+  }
+
+  for (auto &t : threads)
+    t.join();
+
+  return report();
+}
+
+bool k_induction_schedulert::report() const
+{
+  if (bug_k)
+  {
+    log_result(
+      "\nBug found by the base case (k = {})\nVERIFICATION FAILED", bug_k);
+    return true;
+  }
+
+  // A proof only counts if the base case found no bug up to it
+  if (!error && proof_k && bc_clean_up_to > proof_k)
+  {
+    if (proof_step == FORWARD_CONDITION)
+      log_success(
+        "\nSolution found by the forward condition; "
+        "all states are reachable (k = {:d})\n"
+        "VERIFICATION SUCCESSFUL",
+        proof_k);
+    else
+      log_success(
+        "\nSolution found by the inductive step "
+        "(k = {:d})\n"
+        "VERIFICATION SUCCESSFUL",
+        proof_k);
+    return false;
+  }
+
+  // Couldn't find a bug or a proof for the current depth
+  log_fail("\nVERIFICATION UNKNOWN");
+  return false;
+}
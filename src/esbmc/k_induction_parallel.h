@@ -0,0 +1,98 @@
+#ifndef ESBMC_K_INDUCTION_PARALLEL_H
+#define ESBMC_K_INDUCTION_PARALLEL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <esbmc/bmc.h>
+#include <list>
+#include <mutex>
+#include <set>
+
+/**
+ * @brief In-process scheduler for --k-induction-parallel.
+ *
+ * The base case, forward condition and inductive step are checked for
+ * increasing values of k by a fixed number of worker threads, all sharing
+ * the GOTO program and the string table of the process. Workers always pick
+ * the pending (step, k) pair with the smallest k, so that with more workers
+ * than steps several values of k are in flight at once.
+ *
+ * Symbolic execution, encoding and trace building update the shared symbol
+ * table and irept reference counts, so only one bmct does that at a time;
+ * the solvers themselves run concurrently. As soon as the verdict is known,
+ * every solver still running is interrupted.
+ */
+class k_induction_schedulert
+{
+public:
+  k_induction_schedulert(
+    goto_functionst &goto_functions,
+    contextt &context,
+    const optionst &options,
+    uint64_t k_step_base,
+    uint64_t k_step_inc,
+    uint64_t max_k_step,
+    size_t num_workers);
+
+  /// Runs until a verdict is reached, reports it and returns true iff a bug
+  /// was found
+  bool run();
+
+protected:
+  enum stept
+  {
+    BASE_CASE,
+    FORWARD_CONDITION,
+    INDUCTIVE_STEP,
+    NUM_STEPS
+  };
+
+  struct taskt
+  {
+    stept step;
+    uint64_t k;
+    bmct *bmc;
+  };
+
+  goto_functionst &goto_functions;
+  contextt &context;
+  /// Options of each step, before setting the unwind bound
+  optionst step_options[NUM_STEPS];
+  const uint64_t k_step_base;
+  const uint64_t k_step_inc;
+  const uint64_t max_k_step;
+  const size_t num_workers;
+
+  /// Held by the bmct that is not solving, see bmct::set_frontend_mutex()
+  std::mutex frontend_mutex;
+
+  /// Everything below is guarded by state_mutex
+  std::mutex state_mutex;
+  std::condition_variable state_changed;
+  uint64_t next_k[NUM_STEPS];
+  bool enabled[NUM_STEPS];
+  std::list<taskt *> running;
+  size_t active_workers = 0;
+  /// Base case bounds checked without finding a bug, beyond the contiguous
+  /// range below bc_clean_up_to
+  std::set<uint64_t> bc_clean;
+  /// Every base case bound below this one was checked without a bug
+  uint64_t bc_clean_up_to;
+  /// Smallest k at which a bug or proof was found, 0 if none
+  uint64_t bug_k = 0;
+  uint64_t proof_k = 0;
+  stept proof_step = FORWARD_CONDITION;
+  bool error = false;
+  bool decided = false;
+
+  static const char *step_name(stept step);
+
+  bool pick_task(stept &step, uint64_t &k) const;
+  bool is_needed(stept step, uint64_t k) const;
+  void record_result(stept step, uint64_t k, smt_convt::resultt res);
+  void interrupt_unneeded();
+  void worker();
+  bool report() const;
+};
+
+#endif
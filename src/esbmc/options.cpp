@@ -72,6 +72,10 @@ const struct group_opt_templ all_cmd_options[] = {
      {"python",
       boost::program_options::value<std::string>()->value_name("path"),
       "Python interpreter binary to use (searched in $PATH; default: python)"},
+     {"python-cache-dir",
+      boost::program_options::value<std::string>()->value_name("dir"),
+      "cache the parsed Python modules and models in dir, and keep a parser "
+      "process running there to serve later runs"},
      {"override-return-annotation",
       NULL,
       "Override return annotation with inferred type"},
@@ -248,6 +252,10 @@ const struct group_opt_templ all_cmd_options[] = {
     {"partial-loops", NULL, "permit paths with partial loops"},
     {"unroll-loops", NULL, ""},
     {"no-slice", NULL, "do not remove unused equations"},
+    {"compact-guards",
+     NULL,
+     "name the path condition of merged paths with a fresh guard symbol, "
+     "simplified in a hash-consed and-inverter graph"},
     {"multi-fail-fast",
      boost::program_options::value<int>()->value_name("n"),
      "stops after first n VCC violation found in multi property mode"},
@@ -300,6 +308,14 @@ const struct group_opt_templ all_cmd_options[] = {
     {"parallel-solving",
      NULL,
      "solve each VCC in parallel (this activates --multi-property)"},
+    {"parallel-solving-jobs",
+     boost::program_options::value<int>()->value_name("nr"),
+     "maximum number of VCCs solved concurrently by --parallel-solving "
+     "(default: number of hardware threads)"},
+    {"portfolio",
+     boost::program_options::value<std::string>()->value_name("s1,s2,..."),
+     "solve each formula with all the listed solvers at once and take the "
+     "first answer, e.g. z3,bitwuzla,yices"},
     {"smtlib", NULL, "use SMT lib format"},
     {"default-solver",
      boost::program_options::value<std::string>()->value_name("<solver>"),
@@ -354,6 +370,15 @@ const struct group_opt_templ all_cmd_options[] = {
    {{"multi-property",
      NULL,
      "verify satisfiability of all claims of the current bound"},
+    {"claim-cache-dir",
+     boost::program_options::value<std::string>()->value_name("path"),
+     "in multi-property mode, remember the claims proven to hold in this "
+     "directory and skip them in later runs while their sliced formula is "
+     "unchanged"},
+    {"multi-property-incremental",
+     NULL,
+     "in multi-property mode, encode the formula once in a single solver "
+     "and check each claim in its own solver context"},
     {"no-standard-checks", NULL, "disable default checks"},
     {"no-assertions", NULL, "ignore assertions"},
     {"no-bounds-check", NULL, "do not do array bounds check"},
@@ -428,7 +453,12 @@ const struct group_opt_templ all_cmd_options[] = {
      "conditions"},
     {"k-induction-parallel",
      NULL,
-     "prove by k-induction, running each step on a separate process"},
+     "prove by k-induction, running the steps concurrently on separate "
+     "threads"},
+    {"k-induction-parallel-jobs",
+     boost::program_options::value<int>()->value_name("nr"),
+     "number of threads used by --k-induction-parallel (default is 3); more "
+     "threads check several values of k at once"},
     {"k-step",
      boost::program_options::value<int>()->default_value(1)->value_name("nr"),
      "set k increment (default is 1)"},
@@ -444,6 +474,10 @@ const struct group_opt_templ all_cmd_options[] = {
     {"cex-only", NULL, "do not print the state trace"},
     {"bidirectional", NULL, ""},
     {"unlimited-k-steps", NULL, "set max number of iteration to UINT_MAX"},
+    {"incremental-k-solving",
+     NULL,
+     "keep one solver per step across k-steps and only encode the SSA "
+     "steps that differ from the previous k"},
     {"max-inductive-step",
      boost::program_options::value<int>()->default_value(-1)->value_name("nr"),
      ""}}},
@@ -476,6 +510,10 @@ const struct group_opt_templ all_cmd_options[] = {
     {"interval-analysis-csv-dump",
      boost::program_options::value<std::string>(),
      "dump resulting intervals for the analysis in a csv file"},
+    {"interval-analysis-sparse",
+     NULL,
+     "only keep the abstract states where control flow joins and recompute "
+     "the others when needed, reducing memory usage"},
     {"interval-analysis-wrapped",
      NULL,
      "enable analysis using wrapped intervals (disables Integers)"},
@@ -523,12 +561,19 @@ const struct group_opt_templ all_cmd_options[] = {
      "configure memory limit, of form \"100m\" or \"2g\"; without suffix the "
      "default unit is 'm'."},
     {"memstats", NULL, "print memory usage statistics"},
+    {"trace-profile",
+     boost::program_options::value<std::string>()->value_name("file"),
+     "write a timeline of the verification phases to file, in the Chrome "
+     "trace format read by Perfetto"},
     {"timeout",
      boost::program_options::value<std::string>()->value_name("t"),
      "configure time limit, integer followed by {s,m,h}"},
     {"enable-core-dump", NULL, "do not disable core dump output"},
     {"no-simplify", NULL, "do not simplify any expression"},
     {"no-propagation", NULL, "disable constant propagation"},
+    {"irep2-hash-cons",
+     NULL,
+     "share one copy of structurally equal expressions and types"},
     {"gcse",
      NULL,
      "adds intermediate variables to precompute common sub-expressions between "
@@ -6,6 +6,7 @@
 #include <cassert>
 #include <memory>
 #include <sstream>
+#include <vector>
 
 #include <util/std_code.h>
 #include <util/std_expr.h>
@@ -61,8 +62,36 @@ void ai_baset::initialize(const goto_programt &goto_program)
 {
   // we mark everything as unreachable as starting point
 
+  if (!sparse)
+  {
+    forall_goto_program_instructions (i_it, goto_program)
+      get_state(i_it).make_bottom();
+    return;
+  }
+
+  // Only create the states that are kept, see set_sparse(). The calls and
+  // their return sites are kept as do_function_call reads and merges into them
+  if (goto_program.empty())
+    return;
+
+  get_state(goto_program.instructions.begin()).make_bottom();
+
   forall_goto_program_instructions (i_it, goto_program)
-    get_state(i_it).make_bottom();
+  {
+    if (i_it->is_goto() || i_it->is_catch())
+    {
+      for (const auto &target : i_it->targets)
+        get_state(target).make_bottom();
+    }
+    else if (i_it->is_function_call())
+    {
+      get_state(i_it).make_bottom();
+      if (std::next(i_it) != goto_program.instructions.end())
+        get_state(std::next(i_it)).make_bottom();
+    }
+    else if (i_it->is_end_function())
+      get_state(i_it).make_bottom();
+  }
 }
 
 void ai_baset::initialize(const goto_functionst &goto_functions)
@@ -121,49 +150,120 @@ bool ai_baset::visit(
 {
   bool new_data = false;
 
-  statet &current = get_state(l);
-
-  goto_programt::const_targetst successors;
-  goto_program.get_successors(l, successors);
+  // In sparse mode, the instructions whose state is not kept are visited right
+  // away with the state carried over to them, as no other edge leads there
+  std::vector<std::pair<goto_programt::const_targett, std::unique_ptr<statet>>>
+    pending;
+  std::unique_ptr<statet> carried_state;
 
-  for (const auto &to_l : successors)
+  for (;;)
   {
-    if (to_l == goto_program.instructions.end())
-      continue;
+    const statet &current = carried_state ? *carried_state : get_state(l);
 
-    std::unique_ptr<statet> tmp_state(make_temporary_state(current));
+    goto_programt::const_targetst successors;
+    goto_program.get_successors(l, successors);
 
-    statet &new_values = *tmp_state;
+    for (const auto &to_l : successors)
+    {
+      if (to_l == goto_program.instructions.end())
+        continue;
 
-    bool have_new_values = false;
+      bool have_new_values = false;
 
-    if (l->is_function_call() && !goto_functions.function_map.empty())
-    {
-      // this is a big special case
-      const code_function_call2t &code = to_code_function_call2t(l->code);
+      if (l->is_function_call() && !goto_functions.function_map.empty())
+      {
+        // this is a big special case
+        const code_function_call2t &code = to_code_function_call2t(l->code);
 
-      if (do_function_call_rec(l, to_l, code.function, goto_functions, ns))
-        have_new_values = true;
-    }
-    else
-    {
-      // initialize state, if necessary
-      get_state(to_l);
+        if (do_function_call_rec(l, to_l, code.function, goto_functions, ns))
+          have_new_values = true;
+      }
+      else
+      {
+        // Only copy the state for the edges that transform it; the calls above
+        // make their own copies
+        std::unique_ptr<statet> tmp_state(make_temporary_state(current));
+        statet &new_values = *tmp_state;
+
+        new_values.transform(l, to_l, *this, ns);
+
+        if (sparse && !target_is_mapped(to_l))
+        {
+          pending.emplace_back(to_l, std::move(tmp_state));
+          continue;
+        }
+
+        // initialize state, if necessary
+        get_state(to_l);
 
-      new_values.transform(l, to_l, *this, ns);
+        if (merge(new_values, l, to_l))
+          have_new_values = true;
+      }
 
-      if (merge(new_values, l, to_l))
-        have_new_values = true;
+      if (have_new_values)
+      {
+        new_data = true;
+        put_in_working_set(working_set, to_l);
+      }
     }
 
-    if (have_new_values)
+    if (pending.empty())
+      break;
+
+    l = pending.back().first;
+    carried_state = std::move(pending.back().second);
+    pending.pop_back();
+  }
+
+  return new_data;
+}
+
+/// Whether control may go from `i` to the instruction after it, as in
+/// goto_programt::get_successors
+static bool falls_through(const goto_programt::instructiont &i)
+{
+  if (i.is_goto())
+    return !is_true(i.guard);
+  if (i.is_return() || i.is_end_function())
+    return false;
+  if (i.is_assume() || i.is_assert())
+    return !is_false(i.guard);
+  return true;
+}
+
+std::unique_ptr<ai_baset::statet>
+ai_baset::recompute_state_before(goto_programt::const_targett l) const
+{
+  assert(sparse && analysis_ns != nullptr);
+
+  // Walk back to the closest instruction we have the state of; there are no
+  // jumps in between, see initialize()
+  std::vector<goto_programt::const_targett> path;
+  std::unique_ptr<statet> state;
+  for (goto_programt::const_targett at = l; !state;)
+  {
+    if (recomputed_state && at == recomputed_at)
+      state = make_temporary_state(*recomputed_state);
+    else if (target_is_mapped(at))
+      state = make_temporary_state(find_state(at));
+    else
     {
-      new_data = true;
-      put_in_working_set(working_set, to_l);
+      // The first instruction is always kept
+      --at;
+      if (!falls_through(*at))
+        return nullptr;
+      path.push_back(at);
     }
   }
 
-  return new_data;
+  // The domains do not change the analysis from their transformers
+  ai_baset &ai = const_cast<ai_baset &>(*this);
+  for (auto it = path.rbegin(); it != path.rend(); ++it)
+    state->transform(*it, std::next(*it), ai, *analysis_ns);
+
+  recomputed_at = l;
+  recomputed_state = make_temporary_state(*state);
+  return state;
 }
 
 bool ai_baset::do_function_call(
@@ -212,7 +312,11 @@ bool ai_baset::do_function_call(
 
     // do we need to do/re-do the fixedpoint of the body?
     if (new_data)
+    {
+      call_chain.push_back(f_it->first);
       fixedpoint(goto_function.body, goto_functions, ns);
+      call_chain.pop_back();
+    }
   }
 
   // This is the edge from function end to return site.
@@ -282,5 +386,9 @@ void ai_baset::sequential_fixedpoint(
     goto_functions.function_map.find(goto_functions.main_id());
 
   if (f_it != goto_functions.function_map.end())
+  {
+    call_chain.push_back(f_it->first);
     fixedpoint(f_it->second.body, goto_functions, ns);
+    call_chain.pop_back();
+  }
 }
@@ -4,9 +4,11 @@
 #ifndef CPROVER_ANALYSES_AI_H
 #define CPROVER_ANALYSES_AI_H
 
+#include <algorithm>
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <vector>
 #include <goto-programs/abstract-interpretation/ai_domain.h>
 #include <goto-programs/goto_functions.h>
 #include <util/xml.h>
@@ -39,6 +41,8 @@ public:
   void operator()(const goto_programt &goto_program, const namespacet &ns)
   {
     goto_functionst goto_functions;
+    analysis_ns = &ns;
+    recomputed_state.reset();
     initialize(goto_program);
     entry_state(goto_program);
     fixedpoint(goto_program, goto_functions, ns);
@@ -53,12 +57,44 @@ public:
    */
   void operator()(const goto_functionst &goto_functions, const namespacet &ns)
   {
+    analysis_ns = &ns;
+    recomputed_state.reset();
     initialize(goto_functions);
     entry_state(goto_functions);
     fixedpoint(goto_functions, ns);
     finalize();
   }
 
+  /**
+   * @brief Only keep the abstract states where control flow may join
+   *
+   * These are the entry and exit of each function, the jump targets, which
+   * include the loop heads, and the instructions around function calls. Any
+   * other instruction can only be reached from the one before it, so its
+   * state is carried over from there during the fixedpoint and recomputed by
+   * abstract_state_before afterwards. Memory is then proportional to the
+   * number of joins rather than of instructions.
+   *
+   * Must be set before running the analysis.
+   */
+  void set_sparse(bool enable)
+  {
+    sparse = enable;
+  }
+
+  bool is_sparse() const
+  {
+    return sparse;
+  }
+
+  /// Whether the fixedpoint of `function` is being computed, i.e. whether a
+  /// call to it from the instructions being visited is a recursive one
+  bool in_call_chain(const irep_idt &function) const
+  {
+    return std::find(call_chain.begin(), call_chain.end(), function) !=
+           call_chain.end();
+  }
+
   // TODO: add history (for widening!)
 
   virtual std::unique_ptr<statet>
@@ -75,6 +111,7 @@ public:
   /// Resets the domain
   virtual void clear()
   {
+    recomputed_state.reset();
   }
 
   virtual void
@@ -95,9 +132,11 @@ protected:
   /* The fixedpoint is computed through a Work set algorithm which
    * consists in adding nodes that have changed with the current merge
   */
-  // the work-queue is sorted by location number
-  typedef std::unordered_map<unsigned, goto_programt::const_targett>
-    working_sett;
+  // the work-queue is sorted by location number, and the lowest one is visited
+  // first. A loop head comes before the body of its loop, so the body is
+  // iterated until it is stable before moving on to what follows the loop,
+  // as in a weak topological order.
+  typedef std::map<unsigned, goto_programt::const_targett> working_sett;
 
   goto_programt::const_targett get_next(working_sett &working_set);
 
@@ -161,7 +200,25 @@ protected:
     const namespacet &ns) = 0;
   virtual statet &get_state(goto_programt::const_targett l) = 0;
   virtual const statet &find_state(goto_programt::const_targett l) const = 0;
-  virtual std::unique_ptr<statet> make_temporary_state(const statet &s) = 0;
+  virtual bool target_is_mapped(goto_programt::const_targett l) const = 0;
+  virtual std::unique_ptr<statet>
+  make_temporary_state(const statet &s) const = 0;
+
+  /// In sparse mode, the state before `l` when it is not kept, or null if `l`
+  /// cannot be reached
+  std::unique_ptr<statet>
+  recompute_state_before(goto_programt::const_targett l) const;
+
+  bool sparse = false;
+  const namespacet *analysis_ns = nullptr;
+
+  /// Functions whose fixedpoint is running, outermost first
+  std::vector<irep_idt> call_chain;
+
+  /// The last state recomputed, so that going through the instructions in
+  /// order only carries each state over one instruction
+  mutable goto_programt::const_targett recomputed_at;
+  mutable std::unique_ptr<statet> recomputed_state;
 };
 
 // domainT is expected to be derived from ai_domain_baseT
@@ -174,6 +231,8 @@ public:
   {
   }
 
+  /// In sparse mode, only the kept states can be looked up this way; use
+  /// abstract_state_before for the others
   domainT &operator[](goto_programt::const_targett l)
   {
     typename state_mapt::iterator it = state_map.find(l);
@@ -183,7 +242,7 @@ public:
     return it->second;
   }
 
-  bool target_is_mapped(goto_programt::const_targett l) const
+  bool target_is_mapped(goto_programt::const_targett l) const override
   {
     return state_map.count(l) != 0;
   }
@@ -203,6 +262,13 @@ public:
     typename state_mapt::const_iterator it = state_map.find(t);
     if (it == state_map.end())
     {
+      if (sparse)
+      {
+        std::unique_ptr<statet> d = recompute_state_before(t);
+        if (d)
+          return d;
+      }
+
       std::unique_ptr<statet> d = std::make_unique<domainT>();
       assert(d->is_bottom());
       return d;
@@ -252,7 +318,8 @@ protected:
       static_cast<const domainT &>(src), from, to);
   }
 
-  std::unique_ptr<statet> make_temporary_state(const statet &s) override
+  std::unique_ptr<statet>
+  make_temporary_state(const statet &s) const override
   {
     return std::make_unique<domainT>(static_cast<const domainT &>(s));
   }
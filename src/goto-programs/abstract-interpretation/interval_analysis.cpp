@@ -93,7 +93,10 @@ void optimize_function(
   // Inline optimizations
   Forall_goto_program_instructions (i_it, goto_function.body)
   {
-    const interval_domaint &d = interval_analysis[i_it];
+    // The state is recomputed if the analysis is sparse
+    std::unique_ptr<ai_baset::statet> state =
+      interval_analysis.abstract_state_before(i_it);
+    const interval_domaint &d = static_cast<const interval_domaint &>(*state);
 
     // Singleton Propagation
     optimize_expression(i_it->code, d);
@@ -111,11 +114,14 @@ inline void instrument_symbol_constraints(
   goto_functiont &goto_function)
 {
   std::vector<expr2tc> symbol_constraints;
-  auto state_iterator = interval_analysis.state_map.find(it);
-  // We may be trying to instrument an unreachable state
-  if (state_iterator == interval_analysis.state_map.end())
+  // We may be trying to instrument an unreachable state; a sparse analysis
+  // recomputes the states it did not keep
+  if (
+    !interval_analysis.target_is_mapped(it) && !interval_analysis.is_sparse())
     return;
-  const interval_domaint &d = state_iterator->second;
+  std::unique_ptr<ai_baset::statet> state =
+    interval_analysis.abstract_state_before(it);
+  const interval_domaint &d = static_cast<const interval_domaint &>(*state);
   for (const auto &symbol_expr : symbols)
   {
     expr2tc tmp = d.make_expression(symbol_expr);
@@ -274,6 +280,8 @@ void interval_analysis(
   // TODO: add options for instrumentation mode
   ait<interval_domaint> interval_analysis;
   interval_domaint::set_options(options);
+  interval_analysis.set_sparse(
+    options.get_bool_option("interval-analysis-sparse"));
   interval_analysis(goto_functions, ns);
 
   if (options.get_bool_option("interval-analysis-dump"))
@@ -915,11 +915,19 @@ bool contains_float(const expr2tc &e)
 void interval_domaint::transform(
   goto_programt::const_targett from,
   goto_programt::const_targett to,
-  ai_baset &,
+  ai_baset &ai,
   const namespacet &ns)
 {
   (void)ns;
 
+  // The edges into and out of a recursive call close a cycle, see join()
+  if (from->is_function_call() && to != std::next(from))
+    recursive_edge = ai.in_call_chain(to->function);
+  else if (from->is_end_function())
+    recursive_edge = ai.in_call_chain(from->function);
+  else
+    recursive_edge = false;
+
   const goto_programt::instructiont &instruction = *from;
   switch (instruction.type)
   {
@@ -1188,6 +1196,7 @@ bool interval_domaint::join(
 
 bool interval_domaint::join(
   const interval_domaint &b,
+  const goto_programt::const_targett &from,
   const goto_programt::const_targett &to)
 {
   if (b.is_bottom() || is_top())
@@ -1210,11 +1219,18 @@ bool interval_domaint::join(
   // to expend much time on this.
   copy_if_needed();
 
-  const bool is_if_goto = to->is_goto() && !is_true(to->guard);
-  const bool is_guard = to->is_assume() || to->is_assert() || is_if_goto;
+  // Only extrapolate on the edges that may close a cycle, so that the states
+  // elsewhere keep the precision of the plain join. Within a function, every
+  // cycle is a loop and goes through the back edge into its head. With
+  // recursion, cycles also go through the edge from a recursive call to the
+  // entry of the callee, or from its end back to the return site of such a
+  // call; transform() tells those apart from the other calls.
+  const bool is_back_edge =
+    from->is_backwards_goto() && from->targets.front() == to;
+  const bool may_close_cycle = is_back_edge || b.recursive_edge;
 
   // Prevent short-circuit
-  bool result = join(*intervals, *b.intervals, is_guard);
+  bool result = join(*intervals, *b.intervals, may_close_cycle);
   return result;
 }
 
@@ -98,18 +98,23 @@ protected:
   *          merge, which uses it to bring together two different paths
   *          of analysis.
   * @param b: The interval domain, b, to join to this domain.
+  * @param from: Source of the edge along which b flows.
+  * @param to: Instruction this domain is the state of.
   * @return True if the join increases the set represented by *this, False if
   *   there is no change.
   */
-  bool join(const interval_domaint &b, const goto_programt::const_targett &to);
+  bool join(
+    const interval_domaint &b,
+    const goto_programt::const_targett &from,
+    const goto_programt::const_targett &to);
 
 public:
   bool merge(
     const interval_domaint &b,
-    goto_programt::const_targett,
+    goto_programt::const_targett from,
     goto_programt::const_targett to)
   {
-    const bool result = join(b, to);
+    const bool result = join(b, from, to);
     copied = false;
     return result;
   }
@@ -215,6 +220,10 @@ protected:
   /// Is this state a bottom. I.e., there is a contradiction between an assignment and an assume
   bool bottom;
 
+  /// Whether this state was carried into the entry of a function along a
+  /// recursive call, or out of one back to its return site
+  bool recursive_edge = false;
+
   /**
    * @brief Recursively explores an Expression until it reaches a symbol. If the
    * symbol is a BV, then removes it from the int_map
@@ -418,7 +427,7 @@ protected:
   bool join(
     IntervalMap &new_map,
     const IntervalMap &previous_map,
-    const bool is_guard_instruction = true);
+    const bool should_extrapolate_instruction = true);
 
   /**
    * @brief Sets new interval for symbol
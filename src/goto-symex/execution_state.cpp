@@ -1129,28 +1129,21 @@ bool execution_statet::can_execution_continue() const
   return true;
 }
 
-crypto_hash execution_statet::generate_hash() const
+state_fingerprintt execution_statet::generate_hash() const
 {
   auto l2 = std::dynamic_pointer_cast<state_hashing_level2t>(state_level2);
   assert(l2 != nullptr);
 
-  crypto_hash state = l2->generate_l2_state_hash();
-  std::string str = state.to_string();
+  state_fingerprintt state = l2->generate_l2_state_hash();
 
-  for (const auto &it : threads_state)
+  // Thread numbers are keyed from the top, clear of the variable names
+  for (unsigned int i = 0; i < threads_state.size(); i++)
   {
-    goto_programt::const_targett pc = it.source.pc;
-    int id = pc->location_number;
-    std::stringstream s;
-    s << id;
-    str += "!" + s.str();
+    uint64_t pc = threads_state[i].source.pc->location_number;
+    state += state_fingerprintt(pc, 0).contribution(~uint64_t(i));
   }
 
-  crypto_hash h;
-  h.ingest(str.c_str(), str.size());
-  h.fin();
-
-  return h;
+  return state;
 }
 
 crypto_hash execution_statet::update_hash_for_assignment(const expr2tc &rhs)
@@ -1353,8 +1346,6 @@ void execution_statet::state_hashing_level2t::make_assignment(
   const expr2tc &const_value,
   const expr2tc &assigned_value)
 {
-  //  crypto_hash hash;
-
   renaming::level2t::make_assignment(lhs_sym, const_value, assigned_value);
 
   // If there's no body to the assignment, don't hash.
@@ -1362,29 +1353,18 @@ void execution_statet::state_hashing_level2t::make_assignment(
   {
     // XXX - consider whether to use l1 names instead. Recursion, reentrancy.
     crypto_hash hash = owner->update_hash_for_assignment(assigned_value);
-    std::string orig_name = to_symbol2t(lhs_sym).thename.as_string();
-    current_hashes[orig_name] = hash;
-  }
-}
+    const irep_idt &orig_name = to_symbol2t(lhs_sym).thename;
+    state_fingerprintt contribution =
+      state_fingerprintt(hash).contribution(orig_name.get_no());
 
-crypto_hash
-execution_statet::state_hashing_level2t::generate_l2_state_hash() const
-{
-  unsigned int total;
-  size_t hash_sz = sizeof(crypto_hash::hash);
-
-  uint8_t *data =
-    (uint8_t *)alloca(current_hashes.size() * hash_sz * sizeof(uint8_t));
-
-  total = 0;
-  for (const auto &current_hashe : current_hashes)
-  {
-    memcpy(&data[total * hash_sz], current_hashe.second.hash, hash_sz);
-    total++;
+    // Swap the contribution of the previous value for the new one
+    if (state_fingerprintt *old = current_hashes.find_mutable(orig_name))
+    {
+      fingerprint -= *old;
+      *old = contribution;
+    }
+    else
+      current_hashes.insert(orig_name, contribution);
+    fingerprint += contribution;
   }
-
-  crypto_hash c;
-  c.ingest(data, total * hash_sz);
-  c.fin();
-  return c;
 }
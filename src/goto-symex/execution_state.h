@@ -6,6 +6,7 @@
 #include <goto-symex/goto_symex.h>
 #include <goto-symex/goto_symex_state.h>
 #include <goto-symex/renaming.h>
+#include <goto-symex/state_fingerprint.h>
 #include <goto-symex/symex_target.h>
 
 #include <list>
@@ -13,6 +14,7 @@
 #include <set>
 #include <irep2/irep2.h>
 #include <util/message.h>
+#include <util/persistent_map.h>
 #include <util/std_expr.h>
 
 class reachability_treet;
@@ -121,9 +123,18 @@ public:
       expr2tc &lhs_symbol,
       const expr2tc &const_value,
       const expr2tc &assigned_value) override;
-    crypto_hash generate_l2_state_hash() const;
-    typedef std::map<irep_idt, crypto_hash> current_state_hashest;
+    /** @return the fingerprint of all assignments, see current_hashes */
+    state_fingerprintt generate_l2_state_hash() const
+    {
+      return fingerprint;
+    }
+    /** Contribution of each variable's last assigned value to the state
+     *  fingerprint. Persistent, as it is copied along with each state. */
+    typedef persistent_mapt<irep_idt, state_fingerprintt, irep_id_hash>
+      current_state_hashest;
     current_state_hashest current_hashes;
+    /** Sum of current_hashes, updated on each assignment */
+    state_fingerprintt fingerprint;
   };
 
   // Macros
@@ -253,6 +264,17 @@ public:
   /** Like get_dynamic_counter, but with nondet symbols. */
   unsigned int &get_nondet_counter() override;
 
+  /**
+   *  Restart the numbering of dynamic objects and symex nondet symbols.
+   *  The counter is shared by all execution states of the process, so that
+   *  otherwise a second symex run of the same program, e.g. the next k-step,
+   *  names them differently from the first.
+   */
+  static void reset_dynamic_counter()
+  {
+    dynamic_counter = 0;
+  }
+
   /**
    *  Fetch name of current execution guard.
    *  The execution guard being the guard of the interleavings up to this point
@@ -448,13 +470,14 @@ public:
 
   /**
    *  Generate hash of entire execution state.
-   *  This takes all current symbolic assignments to variables contained in the
-   *  l2 renaming object, and their precomputed hashes, concatonates them with
-   *  the current program counter of each thread, and hashes that. This results
-   *  in a full hash of the current execution state.
-   *  @return Hash of entire current execution state.
-   */
-  crypto_hash generate_hash() const;
+   *  This takes the fingerprint of all current symbolic assignments to
+   *  variables, maintained incrementally by the l2 renaming object, and adds
+   *  the current program counter of each thread. This results in a
+   *  fingerprint of the current execution state, in time linear in the number
+   *  of threads only.
+   *  @return Fingerprint of entire current execution state.
+   */
+  state_fingerprintt generate_hash() const;
 
   /**
    *  Generate hash of an expression.
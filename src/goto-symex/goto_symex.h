@@ -7,6 +7,8 @@
 #include <map>
 #include <pointer-analysis/dereference.h>
 #include <stack>
+#include <unordered_map>
+#include <util/guard_manager.h>
 #include <util/i2string.h>
 #include <irep2/irep2.h>
 #include <util/options.h>
@@ -268,6 +270,15 @@ protected:
 
   void merge_locality(const statet::goto_statet &goto_state);
 
+  /**
+   *  Replace a merged guard by a fresh guard symbol.
+   *  With --compact-guards, the disjunction built when states are merged is
+   *  simplified in guard_manager and assigned to a new guard symbol, so that
+   *  the guards of the steps that follow refer to it rather than repeat it.
+   *  @param guard Guard to compact.
+   */
+  void compact_guard(guardt &guard);
+
   /**
    *  Join together a previous jump state into thread state.
    *  This combines together two thread states by using if-then-elses to decide
@@ -858,6 +869,9 @@ protected:
    *  @see guard_identifier
    */
   irep_idt guard_identifier_s;
+  /** Path conditions in a hash-consed graph, for --compact-guards; shared by
+   *  all copies of this object and null unless the option is given. */
+  std::shared_ptr<guard_managert> guard_manager;
   /** Loop numbers. */
   unsigned first_loop;
   /** Number of assertions executed. */
@@ -874,6 +888,9 @@ protected:
   bool constant_propagation;
   /** Namespace we're working in. */
   const namespacet &ns;
+  /** L0 symbol, and with it the type, of each variable that phi_function has
+   *  merged, by name; saves looking up and migrating it again at each merge */
+  std::unordered_map<irep_idt, expr2tc, irep_id_hash> phi_symbols;
   /** Context we're working with */
   contextt &new_context;
   /** GOTO functions that we're operating over. */
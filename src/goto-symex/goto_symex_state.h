@@ -15,6 +15,7 @@
 #include <util/crypto_hash.h>
 #include <util/guard.h>
 #include <util/i2string.h>
+#include <util/trace_profile.h>
 #include <irep2/irep2.h>
 #include <vector>
 
@@ -97,6 +98,9 @@ public:
     guardt guard;
     unsigned int thread_id;
     variable_name_sett local_variables;
+    /** Point in the global L2 state at which this state was taken; only the
+     *  names assigned since can differ when it is merged back in. */
+    renaming::level2t::branch_markt branch_mark;
 
     explicit goto_statet(const goto_symex_statet &s)
       : num_instructions(s.num_instructions),
@@ -105,7 +109,8 @@ public:
         value_set(s.value_set),
         guard(s.guard),
         thread_id(s.source.thread_nr),
-        local_variables(s.top().local_variables)
+        local_variables(s.top().local_variables),
+        branch_mark(s.level2.mark_branch())
     {
     }
 
@@ -116,7 +121,8 @@ public:
         value_set(s.value_set),
         guard(s.guard),
         thread_id(s.thread_id),
-        local_variables(s.local_variables)
+        local_variables(s.local_variables),
+        branch_mark(s.branch_mark)
     {
     }
 
@@ -215,8 +221,14 @@ public:
     /** The stack size of the frame. */
     BigInt stack_frame_total;
 
+    /** When the frame was entered, for --trace-profile */
+    uint64_t trace_start;
+
     framet(unsigned int thread_id)
-      : return_value(expr2tc()), hidden(false), stack_frame_total(0)
+      : return_value(expr2tc()),
+        hidden(false),
+        stack_frame_total(0),
+        trace_start(trace_profilet::enabled() ? trace_profilet::now() : 0)
     {
       level1.thread_id = thread_id;
     }
@@ -10,7 +10,6 @@
 #include <goto-symex/goto_symex.h>
 #include <goto-symex/reachability_tree.h>
 #include <util/config.h>
-#include <util/crypto_hash.h>
 #include <util/expr_util.h>
 #include <util/i2string.h>
 #include <util/message.h>
@@ -104,14 +103,7 @@ int reachability_treet::get_CS_bound() const
 
 bool reachability_treet::check_for_hash_collision() const
 {
-  const execution_statet &ex_state = get_cur_state();
-
-  crypto_hash hash;
-  hash = ex_state.generate_hash();
-  if (hit_hashes.find(hash) != hit_hashes.end())
-    return true;
-
-  return false;
+  return hit_hashes.contains(get_cur_state().generate_hash());
 }
 
 void reachability_treet::post_hash_collision_cleanup()
@@ -122,11 +114,7 @@ void reachability_treet::post_hash_collision_cleanup()
 
 void reachability_treet::update_hash_collision_set()
 {
-  execution_statet &ex_state = get_cur_state();
-
-  crypto_hash hash;
-  hash = ex_state.generate_hash();
-  hit_hashes.insert(hash);
+  hit_hashes.insert(get_cur_state().generate_hash());
 }
 
 void reachability_treet::create_next_state()
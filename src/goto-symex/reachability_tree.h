@@ -6,11 +6,11 @@
 #include <goto-symex/execution_state.h>
 #include <goto-symex/goto_symex.h>
 #include <goto-symex/renaming.h>
+#include <goto-symex/state_fingerprint.h>
 #include <goto-symex/symex_target_equation.h>
 
 #include <unordered_map>
 #include <unordered_set>
-#include <util/crypto_hash.h>
 #include <util/message.h>
 #include <util/options.h>
 
@@ -351,7 +351,7 @@ protected:
   /** Whether partial-order-reduction is enabled */
   bool por;
   /** Set of state hashes we've discovered */
-  std::set<crypto_hash> hit_hashes;
+  state_fingerprint_sett hit_hashes;
   /** Flag as to whether we're picking interleaving directions explicitly.
    *  Corresponds to the --interactive-ileaves option. */
   bool interactive_ileaves;
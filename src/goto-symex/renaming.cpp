@@ -298,7 +298,9 @@ void renaming::level2t::make_assignment(
   assert(
     to_symbol2t(lhs_symbol).rlevel == symbol2t::level1 ||
     to_symbol2t(lhs_symbol).rlevel == symbol2t::level1_global);
-  valuet &entry = current_names[name_record(to_symbol2t(lhs_symbol))];
+  name_record rec(to_symbol2t(lhs_symbol));
+  valuet &entry = current_names[rec];
+  changes->names.insert(rec);
 
   // This'll update entry beneath our feet; could re-engineer it in the future.
   rename(lhs_symbol, entry.count + 1);
@@ -316,6 +318,25 @@ void renaming::level2t::make_assignment(
   entry.constant = const_value;
 }
 
+renaming::level2t::branch_markt renaming::level2t::mark_branch()
+{
+  branch_markt mark = changes;
+  changes = std::make_shared<changed_namest>();
+  changes->parent = mark;
+  return mark;
+}
+
+bool renaming::level2t::changed_since(
+  const branch_markt &mark,
+  name_sett &names) const
+{
+  const changed_namest *set = changes.get();
+  for (; set != nullptr && set != mark.get(); set = set->parent.get())
+    names.insert(set->names.begin(), set->names.end());
+
+  return set != nullptr;
+}
+
 void renaming::level2t::rename_to_record(expr2tc &expr, const name_record &rec)
 {
   assert(expr->expr_id == expr2t::symbol_id);
@@ -1,7 +1,9 @@
 #ifndef _GOTO_SYMEX_RENAMING_H_
 #define _GOTO_SYMEX_RENAMING_H_
 
+#include <memory>
 #include <set>
+#include <unordered_set>
 #include <boost/functional/hash.hpp>
 #include <util/crypto_hash.h>
 #include <util/expr_util.h>
@@ -279,8 +281,37 @@ public:
   typedef std::unordered_map<name_record, valuet, name_rec_hash> current_namest;
 
   current_namest current_names;
-  typedef std::map<const expr2tc, crypto_hash> current_state_hashest;
-  current_state_hashest current_hashes;
+
+  typedef std::unordered_set<name_record, name_rec_hash> name_sett;
+
+  /** Names assigned to between two branch points. Each branch point seals
+   *  the current set and starts a new one on top of it, so that the names
+   *  assigned since a branch point are the union of the sets from the current
+   *  one back to the one it sealed. This lets phi_function visit only the
+   *  names that may differ, rather than every name in current_names.
+   *  Copies of a level2t share the set they were copied with, so that a walk
+   *  may also yield names assigned in another copy: these are just spare
+   *  candidates, whose numbers compare equal. */
+  struct changed_namest
+  {
+    name_sett names;
+    std::shared_ptr<const changed_namest> parent;
+  };
+  typedef std::shared_ptr<const changed_namest> branch_markt;
+
+  /** Seals the set of names assigned so far and starts a new one.
+   *  @return Mark of this branch point, for changed_since */
+  branch_markt mark_branch();
+
+  /** Collects the names assigned since mark_branch returned `mark`.
+   *  @param mark Branch point to look back to.
+   *  @param names Set to add the names to.
+   *  @return False if `mark` is not a branch point of this level2t, or of the
+   *          one it was copied from; the names are then incomplete */
+  bool changed_since(const branch_markt &mark, name_sett &names) const;
+
+protected:
+  std::shared_ptr<changed_namest> changes = std::make_shared<changed_namest>();
 };
 
 } // namespace renaming
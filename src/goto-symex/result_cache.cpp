@@ -0,0 +1,129 @@
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <goto-symex/result_cache.h>
+#include <util/crypto_hash.h>
+#include <util/message.h>
+
+namespace
+{
+const char holds_tag[] = "UNSAT";
+
+// Options read by smt_convt and create_solver that change the formula of a
+// claim; the solver itself is identified by the caller
+const char *const encoding_bool_options[] = {
+  "int-encoding",
+  "ir",
+  "fp2bv",
+  "tuple-node-flattener",
+  "tuple-sym-flattener",
+  "array-flattener",
+  "data-races-check",
+  "smtlib"};
+const char *const encoding_value_options[] = {"smtlib-solver-prog"};
+
+void ingest_expr(const expr2tc &expr, crypto_hash &hash)
+{
+  // Distinguish a nil operand from an absent one
+  uint8_t is_nil = is_nil_expr(expr);
+  hash.ingest(&is_nil, sizeof(is_nil));
+  if (!is_nil)
+    expr->hash(hash);
+}
+} // namespace
+
+claim_result_cachet::claim_result_cachet(std::string dir) : dir(std::move(dir))
+{
+  std::error_code ec;
+  std::filesystem::create_directories(this->dir, ec);
+  if (ec)
+    log_warning(
+      "Could not create claim cache directory {}: {}",
+      this->dir,
+      ec.message());
+}
+
+std::string claim_result_cachet::key(
+  const symex_claim_viewt &view,
+  const std::string &context)
+{
+  crypto_hash hash;
+  hash.ingest(context.data(), context.size());
+
+  for (size_t i = 0; i < view.size(); i++)
+  {
+    if (view.is_ignored(i))
+      continue;
+
+    const symex_target_equationt::SSA_stept &step = view.step(i);
+    // Outputs and skips add nothing to the formula
+    if (step.is_output() || step.is_skip())
+      continue;
+
+    uint8_t type = step.type;
+    hash.ingest(&type, sizeof(type));
+    ingest_expr(step.guard, hash);
+    if (step.is_renumber())
+    {
+      ingest_expr(step.lhs, hash);
+      ingest_expr(step.rhs, hash);
+    }
+    else
+      ingest_expr(step.cond, hash);
+  }
+
+  hash.fin();
+  return hash.to_string();
+}
+
+std::string claim_result_cachet::encoding_options(const optionst &options)
+{
+  std::string res;
+  for (const char *opt : encoding_bool_options)
+    res += fmt::format("{}={}\n", opt, options.get_bool_option(opt));
+  for (const char *opt : encoding_value_options)
+    res += fmt::format("{}={}\n", opt, options.get_option(opt));
+  return res;
+}
+
+std::string claim_result_cachet::entry_path(const std::string &key) const
+{
+  return (std::filesystem::path(dir) / key).string();
+}
+
+bool claim_result_cachet::holds(const std::string &key) const
+{
+  std::ifstream in(entry_path(key));
+  std::string tag;
+  return in && std::getline(in, tag) && tag == holds_tag;
+}
+
+void claim_result_cachet::store_holds(const std::string &key) const
+{
+  // The counter is unique within this process, the random token keeps
+  // processes sharing the directory apart.
+  static const unsigned token = std::random_device{}();
+  static std::atomic<unsigned> counter{0};
+  const std::string path = entry_path(key);
+  const std::string tmp =
+    fmt::format("{}.{:x}.{}.tmp", path, token, counter++);
+
+  {
+    std::ofstream out(tmp);
+    out << holds_tag << "\n";
+    if (!out)
+    {
+      log_warning("Could not write claim cache entry {}", tmp);
+      return;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmp, path, ec);
+  if (ec)
+  {
+    log_warning("Could not write claim cache entry {}: {}", path, ec.message());
+    std::filesystem::remove(tmp, ec);
+  }
+}
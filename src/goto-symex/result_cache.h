@@ -0,0 +1,51 @@
+#pragma once
+
+#include <goto-symex/symex_target_equation.h>
+#include <string>
+#include <util/options.h>
+
+/**
+ * @brief Persistent cache of the claims proven to hold, shared between runs.
+ *
+ * Every entry is a file in the cache directory, named after a digest of the
+ * claim's sliced formula together with a caller-provided context (solver,
+ * tool version). A claim whose cone of influence did not change since an
+ * earlier run therefore maps to the same entry and need not be solved
+ * again. Only unsatisfiable results are recorded: a violated claim still
+ * needs the solver's model to build its counterexample.
+ *
+ * Entries are written to a temporary file and renamed into place, so
+ * concurrent writers, in this or another process, never expose a partial
+ * entry.
+ */
+class claim_result_cachet
+{
+public:
+  /// @param dir cache directory, created if it does not exist yet
+  explicit claim_result_cachet(std::string dir);
+
+  /**
+   * Digest of the steps of `view` that are not ignored, i.e. of the formula
+   * that would be handed to the solver for this claim.
+   */
+  static std::string
+  key(const symex_claim_viewt &view, const std::string &context);
+
+  /**
+   * The options that change how the same steps are encoded for the solver,
+   * e.g. integer/real instead of bit-vector arithmetic, one per line. To be
+   * part of the context of key().
+   */
+  static std::string encoding_options(const optionst &options);
+
+  /// Whether the claim with this key was proven to hold before
+  bool holds(const std::string &key) const;
+
+  /// Records that the claim with this key holds
+  void store_holds(const std::string &key) const;
+
+protected:
+  std::string dir;
+
+  std::string entry_path(const std::string &key) const;
+};
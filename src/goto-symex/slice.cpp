@@ -1,125 +1,380 @@
 #include <goto-symex/slice.h>
 
+#include <boost/functional/hash.hpp>
 #include <util/prefix.h>
+
 static bool no_slice(const symbol2t &sym)
 {
   return config.no_slice_names.count(sym.thename.as_string()) ||
          config.no_slice_ids.count(sym.get_symbol_name());
 }
 
-template <bool Add>
-bool symex_slicet::get_symbols(const expr2tc &expr)
+slice_indext::keyt::keyt(const symbol2t &sym)
+  : name(sym.thename), kind(0), l1_num(0), t_num(0), node_num(0), l2_num(0)
+{
+  switch (sym.rlevel)
+  {
+  case symbol2t::level0:
+  case symbol2t::level1_global:
+    break;
+  case symbol2t::level1:
+    kind = 1;
+    l1_num = sym.level1_num;
+    t_num = sym.thread_num;
+    break;
+  case symbol2t::level2:
+    kind = 2;
+    l1_num = sym.level1_num;
+    t_num = sym.thread_num;
+    node_num = sym.node_num;
+    l2_num = sym.level2_num;
+    break;
+  case symbol2t::level2_global:
+    kind = 3;
+    node_num = sym.node_num;
+    l2_num = sym.level2_num;
+    break;
+  }
+}
+
+size_t slice_indext::key_hash::operator()(const keyt &key) const
+{
+  size_t seed = 0;
+  boost::hash_combine(seed, key.name.get_no());
+  boost::hash_combine(seed, key.kind);
+  boost::hash_combine(seed, key.l1_num);
+  boost::hash_combine(seed, key.t_num);
+  boost::hash_combine(seed, key.node_num);
+  boost::hash_combine(seed, key.l2_num);
+  return seed;
+}
+
+slice_indext::slice_indext(
+  const symex_target_equationt::SSA_stepst &steps,
+  const optionst &options)
+  : nondet_inputs(options.get_bool_option("generate-testcase"))
+{
+  build(steps.size(), [&steps](size_t i) -> const auto & { return steps[i]; });
+}
+
+slice_indext::slice_indext(
+  const symex_claim_viewt &view,
+  const optionst &options)
+  : nondet_inputs(options.get_bool_option("generate-testcase"))
+{
+  build(view.size(), [&view](size_t i) -> const auto & { return view.step(i); });
+}
+
+template <typename StepAt>
+void slice_indext::build(size_t size, StepAt step_at)
+{
+  fine_timet start = current_time();
+  entries.resize(size);
+
+  // For each symbol, the last range of ids it was appended to, plus one
+  std::vector<size_t> stamps;
+  size_t range = 0;
+  auto collect_range = [&](const expr2tc &expr) {
+    collect(expr, ++range, stamps);
+  };
+
+  for (size_t i = 0; i < size; i++)
+  {
+    const symex_target_equationt::SSA_stept &step = step_at(i);
+    entryt &e = entries[i];
+    e.lhs = none;
+    e.nondet_input = false;
+    e.guard_begin = ids.size();
+
+    switch (step.type)
+    {
+    case goto_trace_stept::ASSERT:
+    case goto_trace_stept::ASSUME:
+      collect_range(step.guard);
+      e.operands_begin = ids.size();
+      collect_range(step.cond);
+      break;
+    case goto_trace_stept::ASSIGNMENT:
+    {
+      assert(is_symbol2t(step.lhs));
+      e.lhs = number(to_symbol2t(step.lhs));
+      collect_range(step.guard);
+      e.operands_begin = ids.size();
+      collect_range(step.rhs);
+
+      // Should we add nondet to the dependency list (mostly for test cases)?
+      if (nondet_inputs)
+      {
+        expr2tc nondet = symex_slicet::get_nondet_symbol(step.rhs);
+        e.nondet_input = nondet && is_symbol2t(nondet) &&
+                         has_prefix(
+                           to_symbol2t(nondet).thename.as_string(), "nondet$");
+      }
+      break;
+    }
+    case goto_trace_stept::RENUMBER:
+      assert(is_symbol2t(step.lhs));
+      e.lhs = number(to_symbol2t(step.lhs));
+      e.operands_begin = ids.size();
+      break;
+    default:
+      e.operands_begin = ids.size();
+      break;
+    }
+
+    e.end = ids.size();
+  }
+  build_time = current_time() - start;
+}
+
+unsigned int slice_indext::number(const symbol2t &sym)
+{
+  auto [it, inserted] = numbers.emplace(keyt(sym), pinned.size());
+  if (inserted)
+    pinned.push_back(no_slice(sym));
+  return it->second;
+}
+
+void slice_indext::collect(
+  const expr2tc &expr,
+  size_t range,
+  std::vector<size_t> &stamps)
 {
-  bool res = false;
-  // Recursively look if any of the operands has a inner symbol
-  expr->foreach_operand([this, &res](const expr2tc &e) {
-    if (!is_nil_expr(e))
-      res |= get_symbols<Add>(e);
-    return res;
+  if (is_nil_expr(expr))
+    return;
+
+  expr->foreach_operand([this, range, &stamps](const expr2tc &e) {
+    collect(e, range, stamps);
   });
 
   if (!is_symbol2t(expr))
-    return res;
+    return;
 
-  const symbol2t &s = to_symbol2t(expr);
-  if constexpr (Add)
-    res |= depends.insert(s.get_symbol_name()).second;
-  else
-    res |= no_slice(s) || depends.find(s.get_symbol_name()) != depends.end();
-  return res;
+  unsigned int id = number(to_symbol2t(expr));
+  if (stamps.size() <= id)
+    stamps.resize(id + 1, 0);
+  if (stamps[id] != range)
+  {
+    stamps[id] = range;
+    ids.push_back(id);
+  }
 }
 
-void symex_slicet::run_on_assert(symex_target_equationt::SSA_stept &SSA_step)
+void slice_indext::lookup(const expr2tc &expr, std::vector<unsigned int> &out)
+  const
 {
-  get_symbols<true>(SSA_step.guard);
-  get_symbols<true>(SSA_step.cond);
+  if (is_nil_expr(expr))
+    return;
+
+  expr->foreach_operand([this, &out](const expr2tc &e) { lookup(e, out); });
+
+  if (!is_symbol2t(expr))
+    return;
+
+  auto it = numbers.find(keyt(to_symbol2t(expr)));
+  if (it != numbers.end())
+    out.push_back(it->second);
 }
 
-void symex_slicet::run_on_assume(symex_target_equationt::SSA_stept &SSA_step)
+namespace
 {
-  if (!slice_assumes)
+/// The steps of a formula, as seen by symex_slicet::sweep()
+struct formula_stepst
+{
+  symex_target_equationt::SSA_stepst &steps;
+
+  size_t size() const
   {
-    get_symbols<true>(SSA_step.guard);
-    get_symbols<true>(SSA_step.cond);
-    return;
+    return steps.size();
+  }
+  const symex_target_equationt::SSA_stept &step(size_t i) const
+  {
+    return steps[i];
+  }
+  bool is_ignored(size_t i) const
+  {
+    return steps[i].ignore;
+  }
+  bool is_rewritten(size_t) const
+  {
+    return false;
+  }
+  void set_ignored(size_t i, bool value)
+  {
+    steps[i].ignore = value;
   }
+};
+} // namespace
 
-  if (!get_symbols<false>(SSA_step.cond))
+template <typename Stepst>
+void symex_slicet::sweep(const slice_indext &index, Stepst &steps)
+{
+  depends.assign(index.num_symbols(), false);
+  visited = removed_assumes = removed_assignments = removed_renumbers = 0;
+
+  std::vector<unsigned int> guard, operands;
+  for (size_t i = steps.size(); i-- > 0;)
   {
-    // we don't really need it
-    SSA_step.ignore = true;
-    ++sliced;
-    if (is_symbol2t(SSA_step.cond))
-      log_debug(
-        "slice",
-        "slice ignoring assume symbol {}",
-        to_symbol2t(SSA_step.cond).get_symbol_name());
-    else
-      log_debug("slice", "slice ignoring assume expression");
+    if (steps.is_ignored(i))
+      continue;
+    ++visited;
+
+    const symex_target_equationt::SSA_stept &step = steps.step(i);
+    slice_indext::idst guard_ids = index.guard(i);
+    slice_indext::idst operand_ids = index.operands(i);
+    if (steps.is_rewritten(i))
+    {
+      // The index has what the step said before; look at what it says now
+      guard.clear();
+      operands.clear();
+      index.lookup(step.guard, guard);
+      index.lookup(step.is_assignment() ? step.rhs : step.cond, operands);
+      guard_ids = {guard.data(), guard.data() + guard.size()};
+      operand_ids = {operands.data(), operands.data() + operands.size()};
+    }
+
+    if (!is_needed(index, i, step, guard_ids, operand_ids))
+    {
+      steps.set_ignored(i, true);
+      ++sliced;
+    }
+  }
+}
+
+bool symex_slicet::run(symex_target_equationt::SSA_stepst &eq)
+{
+  sliced = 0;
+  fine_timet algorithm_start = current_time();
+  slice_indext index(eq, options);
+  formula_stepst steps{eq};
+  sweep(index, steps);
+  report(index, true, current_time() - algorithm_start - index.build_time);
+  return true;
+}
+
+bool symex_slicet::run(symex_claim_viewt &view)
+{
+  sliced = 0;
+  fine_timet algorithm_start = current_time();
+  if (shared_index)
+  {
+    sweep(*shared_index, view);
+    report(*shared_index, false, current_time() - algorithm_start);
   }
   else
   {
-    // If we need it, add the symbols to dependency
-    get_symbols<true>(SSA_step.guard);
-    get_symbols<true>(SSA_step.cond);
+    slice_indext index(view, options);
+    sweep(index, view);
+    report(index, true, current_time() - algorithm_start - index.build_time);
   }
+  return true;
 }
 
-void symex_slicet::run_on_assignment(
-  symex_target_equationt::SSA_stept &SSA_step)
+void symex_slicet::report(
+  const slice_indext &index,
+  bool built,
+  fine_timet sweep_time) const
 {
-  assert(is_symbol2t(SSA_step.lhs));
-  // TODO: create an option to ignore nondet symbols (test case generation)
+  log_status(
+    "Slicing time: {}s (removed {} assignments)",
+    time2string((built ? index.build_time : 0) + sweep_time),
+    sliced);
+  log_status(
+    "  numbering {} symbols: {}, sweeping {} steps: {}s (removed {} "
+    "assignments, {} assumes, {} renumbers)",
+    index.num_symbols(),
+    built ? time2string(index.build_time) + "s" : "shared",
+    visited,
+    time2string(sweep_time),
+    removed_assignments,
+    removed_assumes,
+    removed_renumbers);
+}
 
-  if (!get_symbols<false>(SSA_step.lhs))
+bool symex_slicet::is_needed(
+  const slice_indext &index,
+  size_t i,
+  const symex_target_equationt::SSA_stept &SSA_step,
+  slice_indext::idst guard,
+  slice_indext::idst operands)
+{
+  switch (SSA_step.type)
   {
-    // Should we add nondet to the dependency list (mostly for test cases)?
-    if (!slice_nondet)
+  case goto_trace_stept::ASSERT:
+    add(guard);
+    add(operands);
+    return true;
+
+  case goto_trace_stept::ASSUME:
+    if (slice_assumes)
     {
-      auto expr = get_nondet_symbol(SSA_step.rhs);
-      if (expr && is_symbol2t(expr))
+      bool needed = false;
+      for (unsigned int id : operands)
+        needed |= is_needed(id, index);
+      if (!needed)
       {
-        auto &sym = to_symbol2t(expr);
-        if (has_prefix(sym.thename.as_string(), "nondet$"))
-          return;
+        // we don't really need it
+        if (is_symbol2t(SSA_step.cond))
+          log_debug(
+            "slice",
+            "slice ignoring assume symbol {}",
+            to_symbol2t(SSA_step.cond).get_symbol_name());
+        else
+          log_debug("slice", "slice ignoring assume expression");
+        ++removed_assumes;
+        return false;
       }
     }
 
-    // we don't really need it
-    SSA_step.ignore = true;
-    ++sliced;
-    log_debug(
-      "slice",
-      "slice ignoring assignment to symbol {}",
-      to_symbol2t(SSA_step.lhs).get_symbol_name());
-  }
-  else
+    // If we need it, add the symbols to dependency
+    add(guard);
+    add(operands);
+    return true;
+
+  case goto_trace_stept::ASSIGNMENT:
   {
-    get_symbols<true>(SSA_step.guard);
-    get_symbols<true>(SSA_step.rhs);
+    const unsigned int lhs = index.lhs(i);
+    if (!is_needed(lhs, index))
+    {
+      if (index.nondet_input(i))
+        return true;
+
+      // we don't really need it
+      log_debug(
+        "slice",
+        "slice ignoring assignment to symbol {}",
+        to_symbol2t(SSA_step.lhs).get_symbol_name());
+      ++removed_assignments;
+      return false;
+    }
+
+    add(guard);
+    add(operands);
 
     // Remove this symbol as we won't be seeing any references to it further
     // into the history.
-    depends.erase(to_symbol2t(SSA_step.lhs).get_symbol_name());
+    depends[lhs] = false;
+    return true;
   }
-}
 
-void symex_slicet::run_on_renumber(symex_target_equationt::SSA_stept &SSA_step)
-{
-  assert(is_symbol2t(SSA_step.lhs));
+  case goto_trace_stept::RENUMBER:
+    if (!is_needed(index.lhs(i), index))
+    {
+      // we don't really need it
+      log_debug(
+        "slice",
+        "slice ignoring renumbering symbol {}",
+        to_symbol2t(SSA_step.lhs).get_symbol_name());
+      ++removed_renumbers;
+      return false;
+    }
 
-  if (!get_symbols<false>(SSA_step.lhs))
-  {
-    // we don't really need it
-    SSA_step.ignore = true;
-    ++sliced;
-    log_debug(
-      "slice",
-      "slice ignoring renumbering symbol {}",
-      to_symbol2t(SSA_step.lhs).get_symbol_name());
-  }
+    // Don't collect the symbol; this insn has no effect on dependencies.
+    return true;
 
-  // Don't collect the symbol; this insn has no effect on dependencies.
+  default:
+    return true;
+  }
 }
 
 /**
@@ -176,15 +431,7 @@ bool claim_slicer::run(symex_target_equationt::SSA_stepst &steps)
         claim_to_keep) // this is the assertion that we should not skip!
       {
         it->ignore = false;
-        if (!is_goto_cov)
-          // obtain the guard info from the assertions
-          claim_msg = from_expr(ns, "", it->source.pc->guard);
-        else
-          // in goto-coverage mode, the assertions are converted to assert(0）
-          // the original guards are stored in comment.
-          claim_msg = it->comment;
-        claim_loc = it->source.pc->location.as_string();
-        claim_cstr = it->comment + " at " + claim_loc;
+        record_claim(*it);
         continue;
       }
 
@@ -208,6 +455,58 @@ bool claim_slicer::run(symex_target_equationt::SSA_stepst &steps)
 
   return true;
 }
+
+bool claim_slicer::run(symex_claim_viewt &view)
+{
+  sliced = 0;
+  fine_timet algorithm_start = current_time();
+  size_t counter = 1;
+  for (size_t i = 0; i < view.size(); i++)
+  {
+    const symex_target_equationt::SSA_stept &step = view.step(i);
+    if (!step.is_assert())
+      continue;
+
+    if (counter++ == claim_to_keep)
+    {
+      view.set_ignored(i, false);
+      record_claim(step);
+      continue;
+    }
+
+    view.set_ignored(i, true);
+    ++sliced;
+  }
+
+  fine_timet algorithm_stop = current_time();
+  if (show_slice_info)
+    log_status(
+      "Slicing for Claim {} ({}s)",
+      claim_msg,
+      time2string(algorithm_stop - algorithm_start));
+  else
+    log_debug(
+      "c++",
+      "Slicing for Claim {} ({}s)",
+      claim_msg,
+      time2string(algorithm_stop - algorithm_start));
+
+  return true;
+}
+
+void claim_slicer::record_claim(const symex_target_equationt::SSA_stept &step)
+{
+  if (!is_goto_cov)
+    // obtain the guard info from the assertions
+    claim_msg = from_expr(ns, "", step.source.pc->guard);
+  else
+    // in goto-coverage mode, the assertions are converted to assert(0）
+    // the original guards are stored in comment.
+    claim_msg = id2string(step.comment);
+  claim_loc = step.source.pc->location.as_string();
+  claim_cstr = id2string(step.comment) + " at " + claim_loc;
+}
+
 // Recursively try to extract the nondet symbol of an expression
 expr2tc symex_slicet::get_nondet_symbol(const expr2tc &expr)
 {
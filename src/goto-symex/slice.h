@@ -7,6 +7,8 @@
 #include <util/options.h>
 #include <boost/range/adaptor/reversed.hpp>
 #include <langapi/language_util.h>
+#include <limits>
+#include <unordered_map>
 
 /* Base interface */
 class slicer : public ssa_step_algorithm
@@ -61,6 +63,8 @@ public:
     }
   };
   bool run(symex_target_equationt::SSA_stepst &) override;
+  /// Same as above, on a per-claim view of a shared formula
+  bool run(symex_claim_viewt &view);
   size_t claim_to_keep;
   std::string claim_msg;
   std::string claim_loc;
@@ -68,6 +72,144 @@ public:
   bool show_slice_info;
   bool is_goto_cov;
   namespacet ns;
+
+protected:
+  /// Fills in the claim_* fields from the assertion being kept
+  void record_claim(const symex_target_equationt::SSA_stept &step);
+};
+
+/**
+ * The SSA symbols of a formula numbered densely, and for every step the
+ * numbers of the symbols the symex slicer looks at. Building the index is the
+ * only part of slicing that walks expressions and hashes symbols; slicing
+ * itself then only tests and sets bits. The slicers of all the claims of one
+ * formula can share an index.
+ */
+class slice_indext
+{
+public:
+  slice_indext(
+    const symex_target_equationt::SSA_stepst &steps,
+    const optionst &options);
+  /// Indexes the steps as seen by `view`, i.e. including its rewrites
+  slice_indext(const symex_claim_viewt &view, const optionst &options);
+
+  static constexpr unsigned int none = std::numeric_limits<unsigned>::max();
+
+  /// Numbers of some symbols, each once
+  struct idst
+  {
+    const unsigned int *first;
+    const unsigned int *last;
+
+    const unsigned int *begin() const
+    {
+      return first;
+    }
+    const unsigned int *end() const
+    {
+      return last;
+    }
+  };
+
+  size_t num_symbols() const
+  {
+    return pinned.size();
+  }
+
+  /// Number of the symbol assigned or renumbered by step `i`, or none
+  unsigned int lhs(size_t i) const
+  {
+    return entries[i].lhs;
+  }
+
+  /// Symbols in the guard of step `i`
+  idst guard(size_t i) const
+  {
+    return range(entries[i].guard_begin, entries[i].operands_begin);
+  }
+
+  /// Symbols in the condition of assert or assume step `i`, or in the
+  /// right-hand side of assignment step `i`
+  idst operands(size_t i) const
+  {
+    return range(entries[i].operands_begin, entries[i].end);
+  }
+
+  /// Whether assignment step `i` copies a nondet input that must be kept for
+  /// test case generation
+  bool nondet_input(size_t i) const
+  {
+    return entries[i].nondet_input;
+  }
+
+  /// Whether symbol `id` must never be sliced, see config.no_slice_names
+  bool is_pinned(unsigned int id) const
+  {
+    return pinned[id];
+  }
+
+  /// Appends the numbers of the symbols in `expr` to `ids`, skipping those
+  /// that occur in no indexed step
+  void lookup(const expr2tc &expr, std::vector<unsigned int> &ids) const;
+
+  /// Time spent building the index
+  fine_timet build_time = 0;
+
+protected:
+  /// Identifies an SSA symbol as symbol2t::get_symbol_name() does, without
+  /// building that name
+  struct keyt
+  {
+    explicit keyt(const symbol2t &sym);
+
+    bool operator==(const keyt &ref) const
+    {
+      return name == ref.name && kind == ref.kind && l1_num == ref.l1_num &&
+             t_num == ref.t_num && node_num == ref.node_num &&
+             l2_num == ref.l2_num;
+    }
+
+    irep_idt name;
+    unsigned int kind;
+    unsigned int l1_num;
+    unsigned int t_num;
+    unsigned int node_num;
+    unsigned int l2_num;
+  };
+
+  struct key_hash
+  {
+    size_t operator()(const keyt &key) const;
+  };
+
+  struct entryt
+  {
+    unsigned int lhs;
+    bool nondet_input;
+    size_t guard_begin;
+    size_t operands_begin;
+    size_t end;
+  };
+
+  std::unordered_map<keyt, unsigned int, key_hash> numbers;
+  std::vector<entryt> entries;
+  std::vector<unsigned int> ids;
+  std::vector<bool> pinned;
+  const bool nondet_inputs;
+
+  idst range(size_t begin, size_t end) const
+  {
+    return {ids.data() + begin, ids.data() + end};
+  }
+
+  template <typename StepAt>
+  void build(size_t size, StepAt step_at);
+  unsigned int number(const symbol2t &sym);
+  /// Appends the numbers of the symbols in `expr` to `ids`, unless `stamps`
+  /// says they were already appended for `range`
+  void
+  collect(const expr2tc &expr, size_t range, std::vector<size_t> &stamps);
 };
 
 /**
@@ -78,13 +220,23 @@ public:
  * It works by constructing a symbol dependency list by transversing
  * the SSA formula in reverse order. If any assume, assignment, or renumber
  * step does not belong into this dependency, then it will be ignored.
+ *
+ * Symbols are tracked by their number in a slice_indext, with one bit per
+ * symbol for the dependency list.
  */
 class symex_slicet : public slicer
 {
 public:
-  explicit symex_slicet(const optionst &options)
+  /**
+   * @param index the index of the formula to be sliced, shared with other
+   * slicers; if null, each run builds its own
+   */
+  explicit symex_slicet(
+    const optionst &options,
+    const slice_indext *index = nullptr)
     : slice_assumes(options.get_bool_option("slice-assumes")),
-      slice_nondet(!options.get_bool_option("generate-testcase"))
+      options(options),
+      shared_index(index)
   {
   }
 
@@ -94,43 +246,10 @@ public:
    * assignment, renumber or assume does not contain one
    * of the dependency symbols, then it will be ignored.
    *
-   * @param eq symex formula to be sliced
-   */
-  bool run(symex_target_equationt::SSA_stepst &eq) override
-  {
-    sliced = 0;
-    fine_timet algorithm_start = current_time();
-    for (auto &step : boost::adaptors::reverse(eq))
-    {
-      if (step.ignore)
-        continue;
-      run_on_step(step);
-    }
-    fine_timet algorithm_stop = current_time();
-    log_status(
-      "Slicing time: {}s (removed {} assignments)",
-      time2string(algorithm_stop - algorithm_start),
-      sliced);
-    return true;
-  }
-
-  /**
-   * Holds the symbols the current equation depends on.
-   */
-  std::unordered_set<std::string> depends;
-
-  static expr2tc get_nondet_symbol(const expr2tc &expr);
-
-  /**
-   * Marks SSA_steps to be ignored which have no effects on the target equation,
-   * according to the options set in the `config`.
-   *
    * Notably, this function depends on the global `config`:
-   *  - "no-slice" in `options` -> perform only simple slicing: ignore everything
-   *    after the final assertion
    *  - "slice-assumes" in `options` -> also perform slicing of assumption steps
    *  - `config.no_slice_names` and `config.no_slice_ids` -> suppress slicing of
-   *    particular symbols in non-simple slicing mode.
+   *    particular symbols.
    *
    *    * Note 1: ASSERTS are not sliced, only their symbols are added
    * into the #depends
@@ -138,93 +257,73 @@ public:
    *    * Note 2: Similar to ASSERTS, if 'slice-assumes' option is
    * is not enabled. Then only its symbols are added into the
    * #depends
-
    *
-   * @param eq The target equation containing the SSA steps to perform program
-   *           slicing on.
-   * @return Whether any step was sliced away
+   * @param eq symex formula to be sliced
+   */
+  bool run(symex_target_equationt::SSA_stepst &eq) override;
+
+  /**
+   * Same as above, on a per-claim view of a shared formula: only the view's
+   * ignore bits are updated, the shared steps are left untouched.
    */
+  bool run(symex_claim_viewt &view);
+
+  static expr2tc get_nondet_symbol(const expr2tc &expr);
 
 protected:
   /// whether assumes should be sliced
   const bool slice_assumes;
-  /// Whether we should slice nondet symbols
-  const bool slice_nondet;
+  const optionst &options;
+  const slice_indext *shared_index;
 
   /**
-   * Recursively explores the operands of an expression \expr
-   * If a symbol is found, then it is added into the #depends
-   * member if `Add` is true, otherwise returns true.
-   *
-   * @param expr expression to extract every symbol
-   * @return true if at least one symbol was found
+   * Holds the symbols the current equation depends on, by their number in
+   * the index.
    */
-  template <bool Add>
-  bool get_symbols(const expr2tc &expr);
+  std::vector<bool> depends;
 
-  /**
-   * Remove unneeded assumes from the formula
-   *
-   * Check if the Assume cond symbol is in the #depends, if
-   * it is not then mark the \SSA_Step as ignored.
-   *
-   * If the assume cond is in the #depends, then add its guards
-   * and cond into the #depends
-   *
-   * Note 1: All the conditions operands are going to be added
-   * into the #depends. This makes that the condition itself as
-   * a "reverse taint"
-   *
-   * TODO: What happens if the ASSUME would result in false?
-   *
-   * @param SSA_step an assume step
-   */
-  void run_on_assert(symex_target_equationt::SSA_stept &SSA_step) override;
+  /// Per-phase counters of the last run
+  size_t visited = 0;
+  size_t removed_assumes = 0;
+  size_t removed_assignments = 0;
+  size_t removed_renumbers = 0;
 
   /**
-   * Remove unneeded assumes from the formula
-   *
-   * Check if the Assume cond symbol is in the #depends, if
-   * it is not then mark the \SSA_Step as ignored.
-   *
-   * If the assume cond is in the #depends, then add its guards
-   * and cond into the #depends
-   *
-   * Note 1: All the conditions operands are going to be added
-   * into the #depends. This makes that the condition itself as
-   * a "reverse taint"
-   *
-   * TODO: What happens if the ASSUME would result in false?
-   *
-   * @param SSA_step an assume step
+   * Walks the steps of `steps` backwards and marks those that are not
+   * needed as ignored. The symbols of steps rewritten since `index` was
+   * built are looked up again.
    */
-  void run_on_assume(symex_target_equationt::SSA_stept &SSA_step) override;
+  template <typename Stepst>
+  void sweep(const slice_indext &index, Stepst &steps);
 
   /**
-   * Remove unneeded assignments from the formula
+   * Decides whether step `i` is needed, given the steps after it.
+   * If so, the symbols it depends on are added into the #depends.
    *
-   * Check if the LHS symbol is in the #depends, if
-   * it is not then mark the \SSA_Step as ignored.
-   *
-   * If the assume cond is in the #depends, then add its guards
-   * and cond into the #depends
-   *
-   * @param SSA_step an assignment step
+   * @param guard symbols of the guard of the step
+   * @param operands symbols of its condition or right-hand side
+   * @return false if the step can be ignored
    */
-  void run_on_assignment(symex_target_equationt::SSA_stept &SSA_step) override;
+  bool is_needed(
+    const slice_indext &index,
+    size_t i,
+    const symex_target_equationt::SSA_stept &SSA_step,
+    slice_indext::idst guard,
+    slice_indext::idst operands);
 
-  /**
-   * Remove unneeded renumbers from the formula
-   *
-   * Check if the LHS symbol is in the #depends, if
-   * it is not then mark the \SSA_Step as ignored.
-   *
-   * If the assume cond is in the #depends, then add its guards
-   * and cond into the #depends
-   *
-   * @param SSA_step an renumber step
-   */
-  void run_on_renumber(symex_target_equationt::SSA_stept &SSA_step) override;
+  bool is_needed(unsigned int id, const slice_indext &index) const
+  {
+    return id != slice_indext::none && (depends[id] || index.is_pinned(id));
+  }
+
+  void add(slice_indext::idst ids)
+  {
+    for (unsigned int id : ids)
+      depends[id] = true;
+  }
+
+  void report(const slice_indext &index, bool built, fine_timet sweep_time)
+    const;
 };
 
 #endif
@@ -0,0 +1,159 @@
+#ifndef _GOTO_SYMEX_STATE_FINGERPRINT_H_
+#define _GOTO_SYMEX_STATE_FINGERPRINT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <util/crypto_hash.h>
+#include <vector>
+
+/**
+ *  128 bit fingerprint of an execution state, for --state-hashing.
+ *
+ *  A fingerprint is the sum of the contributions of each part of the state,
+ *  e.g. each variable and the value last assigned to it. As addition is
+ *  invertible, a fingerprint is kept up to date on every assignment by
+ *  removing the contribution of the old value and adding that of the new one,
+ *  rather than by rehashing the whole state whenever it is looked up.
+ */
+struct state_fingerprintt
+{
+  uint64_t lo = 0;
+  uint64_t hi = 0;
+
+  state_fingerprintt() = default;
+
+  state_fingerprintt(uint64_t _lo, uint64_t _hi) : lo(_lo), hi(_hi)
+  {
+  }
+
+  /** Fingerprint of a digest, e.g. that of an assigned value */
+  explicit state_fingerprintt(const crypto_hash &h)
+  {
+    static_assert(sizeof(h.hash) >= sizeof(lo) + sizeof(hi));
+    const char *bytes = reinterpret_cast<const char *>(h.hash);
+    memcpy(&lo, bytes, sizeof(lo));
+    memcpy(&hi, bytes + sizeof(lo), sizeof(hi));
+  }
+
+  /** @return the contribution of this value when held by `key`, such that
+   *  the same value under different keys contributes differently */
+  state_fingerprintt contribution(uint64_t key) const
+  {
+    uint64_t k = mix(key);
+    return {mix(lo ^ k), mix(hi ^ (k + 0x9e3779b97f4a7c15ULL))};
+  }
+
+  state_fingerprintt &operator+=(const state_fingerprintt &other)
+  {
+    lo += other.lo;
+    hi += other.hi;
+    return *this;
+  }
+
+  state_fingerprintt &operator-=(const state_fingerprintt &other)
+  {
+    lo -= other.lo;
+    hi -= other.hi;
+    return *this;
+  }
+
+  bool operator==(const state_fingerprintt &other) const
+  {
+    return lo == other.lo && hi == other.hi;
+  }
+
+  bool operator!=(const state_fingerprintt &other) const
+  {
+    return !(*this == other);
+  }
+
+  /** The splitmix64 finalizer */
+  static uint64_t mix(uint64_t x)
+  {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+  }
+};
+
+/**
+ *  Set of fingerprints, stored inline in an open addressing table with
+ *  linear probing. Fingerprints are already uniformly distributed, so their
+ *  low bits serve as hash directly.
+ */
+class state_fingerprint_sett
+{
+public:
+  /** @return true if `f` is in the set */
+  bool contains(const state_fingerprintt &f) const
+  {
+    if (is_empty(f))
+      return has_empty;
+    if (slots.empty())
+      return false;
+    return slots[find_slot(f)] == f;
+  }
+
+  /** @return true if `f` was not in the set yet */
+  bool insert(const state_fingerprintt &f)
+  {
+    if (is_empty(f))
+    {
+      bool inserted = !has_empty;
+      has_empty = true;
+      return inserted;
+    }
+
+    // Keep the table at most half full
+    if (2 * (count + 1) > slots.size())
+      grow();
+
+    state_fingerprintt &slot = slots[find_slot(f)];
+    if (slot == f)
+      return false;
+    slot = f;
+    count++;
+    return true;
+  }
+
+  size_t size() const
+  {
+    return count + has_empty;
+  }
+
+protected:
+  /** The all zero fingerprint marks unused slots, and is tracked separately */
+  static bool is_empty(const state_fingerprintt &f)
+  {
+    return f == state_fingerprintt();
+  }
+
+  /** @return the slot holding `f`, or else the unused one it belongs in */
+  size_t find_slot(const state_fingerprintt &f) const
+  {
+    const size_t mask = slots.size() - 1;
+    size_t i = f.lo & mask;
+    while (!is_empty(slots[i]) && slots[i] != f)
+      i = (i + 1) & mask;
+    return i;
+  }
+
+  void grow()
+  {
+    std::vector<state_fingerprintt> old(slots.empty() ? 64 : 2 * slots.size());
+    old.swap(slots);
+    for (const state_fingerprintt &f : old)
+      if (!is_empty(f))
+        slots[find_slot(f)] = f;
+  }
+
+  /** Size is zero or a power of two */
+  std::vector<state_fingerprintt> slots;
+  size_t count = 0;
+  bool has_empty = false;
+};
+
+#endif /* _GOTO_SYMEX_STATE_FINGERPRINT_H_ */
@@ -19,6 +19,10 @@ goto_symext::goto_symext(
   optionst &opts)
   : options(opts),
     guard_identifier_s("goto_symex::guard"),
+    guard_manager(
+      options.get_bool_option("compact-guards")
+        ? std::make_shared<guard_managert>()
+        : nullptr),
     first_loop(0),
     total_claims(0),
     remaining_claims(0),
@@ -93,6 +97,7 @@ goto_symext &goto_symext::operator=(const goto_symext &sym)
   total_claims = sym.total_claims;
   remaining_claims = sym.remaining_claims;
   guard_identifier_s = sym.guard_identifier_s;
+  guard_manager = sym.guard_manager;
   depth_limit = sym.depth_limit;
   break_insn = sym.break_insn;
   memory_leak_check = sym.memory_leak_check;
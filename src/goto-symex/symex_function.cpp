@@ -565,6 +565,13 @@ void goto_symext::pop_frame()
   if (!frame.function_identifier.empty())
     --cur_state->function_unwind[frame.function_identifier];
 
+  if (trace_profilet::enabled() && !frame.function_identifier.empty())
+    trace_profilet::span(
+      "symex",
+      frame.function_identifier.as_string(),
+      frame.trace_start,
+      {{"thread", frame.level1.thread_id}});
+
   cur_state->pop_frame();
 }
 
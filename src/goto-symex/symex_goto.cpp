@@ -286,10 +286,53 @@ void goto_symext::merge_gotos()
     cur_state->guard = std::move(new_guard);
   }
 
+  compact_guard(cur_state->guard);
+
   // clean up to save some memory
   frame.goto_state_map.erase(state_map_it);
 }
 
+void goto_symext::compact_guard(guardt &guard)
+{
+  if (!guard_manager || guard.is_true() || guard.is_false())
+    return;
+
+  // Guards that are already a single symbol are as small as they get
+  expr2tc guard_expr = guard.as_expr();
+  if (
+    is_symbol2t(guard_expr) ||
+    (is_not2t(guard_expr) && is_symbol2t(to_not2t(guard_expr).value)))
+    return;
+
+  expr2tc new_rhs =
+    guard_manager->as_expr(guard_manager->from_expr(guard_expr));
+
+  guard.make_true();
+  if (
+    is_constant_bool2t(new_rhs) || is_symbol2t(new_rhs) ||
+    (is_not2t(new_rhs) && is_symbol2t(to_not2t(new_rhs).value)))
+  {
+    guard.add(new_rhs);
+    return;
+  }
+
+  expr2tc guard_symbol = guard_identifier();
+  cur_state->assignment(guard_symbol, new_rhs);
+
+  target->assignment(
+    gen_true_expr(),
+    guard_symbol,
+    guard_symbol,
+    new_rhs,
+    expr2tc(),
+    cur_state->source,
+    cur_state->gen_stack_trace(),
+    true,
+    first_loop);
+
+  guard.add(guard_symbol);
+}
+
 void goto_symext::merge_locality(const statet::goto_statet &src)
 {
   if (cur_state->guard.is_false())
@@ -318,7 +361,6 @@ void goto_symext::phi_function(const statet::goto_statet &goto_state)
   if (goto_state.guard.is_false() && cur_state->guard.is_false())
     return;
 
-  // go over all variables to see what changed
   const auto &variables = cur_state->level2.current_names;
 
   const auto &goto_variables = goto_state.level2.current_names;
@@ -334,11 +376,28 @@ void goto_symext::phi_function(const statet::goto_statet &goto_state)
     tmp_guard -= cur_state->guard;
   }
 
-  for (const auto &[variable, _] : variables)
+  // Only the variables assigned since the branch point can have changed. If
+  // the branch point can't be traced back to, go over all variables instead.
+  renaming::level2t::name_sett changed;
+  if (!cur_state->level2.changed_since(goto_state.branch_mark, changed))
   {
-    if (
-      goto_state.level2.current_number(variable) ==
-      cur_state->level2.current_number(variable))
+    for (const auto &[variable, _] : variables)
+      changed.insert(variable);
+  }
+
+  for (const auto &variable : changed)
+  {
+    auto it = variables.find(variable);
+    if (it == variables.end())
+      continue; // not a variable here any more
+
+    // If the variable was deleted in this branch, don't create an assignment
+    // for it
+    auto goto_it = goto_variables.find(variable);
+    if (goto_it == goto_variables.end())
+      continue;
+
+    if (goto_it->second.count == it->second.count)
       continue; // not changed
 
     if (variable.base_name == guard_identifier_s)
@@ -347,20 +406,18 @@ void goto_symext::phi_function(const statet::goto_statet &goto_state)
     if (has_prefix(variable.base_name.as_string(), "symex::invalid_object"))
       continue;
 
-    // If the variable was deleted in this branch, don't create an assignment
-    // for it
-    if (goto_variables.find(variable) == goto_variables.end())
-      continue;
-
     // changed!
-    const symbolt &symbol = *ns.lookup(variable.base_name);
+    expr2tc &symbol = phi_symbols[variable.base_name];
+    if (is_nil_expr(symbol))
+      migrate_expr(symbol_expr(*ns.lookup(variable.base_name)), symbol);
 
-    type2tc type = migrate_type(symbol.type);
+    const expr2tc &lhs = symbol;
+    const type2tc &type = lhs->type;
 
-    expr2tc cur_state_rhs = symbol2tc(type, symbol.id);
+    expr2tc cur_state_rhs = lhs;
     renaming::level2t::rename_to_record(cur_state_rhs, variable);
 
-    expr2tc goto_state_rhs = symbol2tc(type, symbol.id);
+    expr2tc goto_state_rhs = lhs;
     renaming::level2t::rename_to_record(goto_state_rhs, variable);
 
     expr2tc rhs;
@@ -380,8 +437,6 @@ void goto_symext::phi_function(const statet::goto_statet &goto_state)
       simplify(rhs);
     }
 
-    expr2tc lhs;
-    migrate_expr(symbol_expr(symbol), lhs);
     expr2tc new_lhs = lhs;
 
     // Again, specify which l1 data object we're going to make the assignment
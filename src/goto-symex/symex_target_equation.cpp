@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cassert>
 #include <goto-symex/goto_symex.h>
 #include <goto-symex/goto_symex_state.h>
@@ -41,13 +42,23 @@ void symex_target_equationt::assignment(
   SSA_step.cond = equality2tc(lhs, rhs);
   SSA_step.type = goto_trace_stept::ASSIGNMENT;
   SSA_step.source = source;
-  SSA_step.stack_trace = stack_trace;
+  SSA_step.stack_trace = share_stack_trace(std::move(stack_trace));
   SSA_step.loop_number = loop_number;
 
   if (debug_print)
     debug_print_step(SSA_step);
 }
 
+std::shared_ptr<const std::vector<stack_framet>>
+symex_target_equationt::share_stack_trace(
+  std::vector<stack_framet> &&stack_trace)
+{
+  if (!last_stack_trace || *last_stack_trace != stack_trace)
+    last_stack_trace =
+      std::make_shared<const std::vector<stack_framet>>(std::move(stack_trace));
+  return last_stack_trace;
+}
+
 void symex_target_equationt::output(
   const expr2tc &guard,
   const sourcet &source,
@@ -102,7 +113,7 @@ void symex_target_equationt::assertion(
   SSA_step.type = goto_trace_stept::ASSERT;
   SSA_step.source = source;
   SSA_step.comment = msg;
-  SSA_step.stack_trace = stack_trace;
+  SSA_step.stack_trace = share_stack_trace(std::move(stack_trace));
   SSA_step.loop_number = loop_number;
 
   if (debug_print)
@@ -142,6 +153,15 @@ void symex_target_equationt::convert(smt_convt &smt_conv)
     smt_conv.assert_ast(smt_conv.make_n_ary_or(assertions));
 }
 
+void symex_target_equationt::convert_without_assertions(smt_convt &smt_conv)
+{
+  smt_convt::ast_vec assertions;
+  smt_astt assumpt_ast = smt_conv.convert_ast(gen_true_expr());
+
+  for (auto &SSA_step : SSA_steps)
+    convert_internal_step(smt_conv, assumpt_ast, assertions, SSA_step);
+}
+
 void symex_target_equationt::convert_internal_step(
   smt_convt &smt_conv,
   smt_astt &assumpt_ast,
@@ -363,18 +383,12 @@ void symex_target_equationt::check_for_duplicate_assigns() const
 
 unsigned int symex_target_equationt::clear_assertions()
 {
-  unsigned int num_asserts = 0;
-
-  for (SSA_stepst::iterator it = SSA_steps.begin(); it != SSA_steps.end(); it++)
-  {
-    if (it->type == goto_trace_stept::ASSERT)
-    {
-      SSA_stepst::iterator it2 = it;
-      it--;
-      SSA_steps.erase(it2);
-      num_asserts++;
-    }
-  }
+  auto first_assert =
+    std::remove_if(SSA_steps.begin(), SSA_steps.end(), [](const SSA_stept &s) {
+      return s.is_assert();
+    });
+  unsigned int num_asserts = std::distance(first_assert, SSA_steps.end());
+  SSA_steps.erase(first_assert, SSA_steps.end());
 
   return num_asserts;
 }
@@ -421,42 +435,18 @@ runtime_encoded_equationt::runtime_encoded_equationt(
 {
   assert_vec_list.emplace_back();
   assumpt_chain.push_back(conv.convert_ast(gen_true_expr()));
-  cvt_progress = SSA_steps.end();
+  cvt_progress = 0;
 }
 
 void runtime_encoded_equationt::flush_latest_instructions()
 {
-  if (SSA_steps.size() == 0)
-    return;
-
-  SSA_stepst::iterator run_it = cvt_progress;
-  // Scenarios:
-  // * We're at the start of running, in which case cvt_progress == end
-  // * We're in the middle, but nothing is left to push, so run_it + 1 == end
-  // * We're in the middle, and there's more to convert.
-  if (run_it == SSA_steps.end())
-  {
-    run_it = SSA_steps.begin();
-  }
-  else
-  {
-    run_it++;
-    if (run_it == SSA_steps.end())
-    {
-      // There is in fact, nothing to do
-      return;
-    }
-
-    // Just roll on
-  }
-
-  // Now iterate from the start insn to convert, to the end of the list.
-  for (; run_it != SSA_steps.end(); ++run_it)
+  // Convert everything that was appended since the last flush.
+  for (; cvt_progress < SSA_steps.size(); cvt_progress++)
     convert_internal_step(
-      conv, assumpt_chain.back(), assert_vec_list.back(), *run_it);
-
-  run_it--;
-  cvt_progress = run_it;
+      conv,
+      assumpt_chain.back(),
+      assert_vec_list.back(),
+      SSA_steps[cvt_progress]);
 }
 
 void runtime_encoded_equationt::push_ctx()
@@ -472,13 +462,8 @@ void runtime_encoded_equationt::push_ctx()
 
 void runtime_encoded_equationt::pop_ctx()
 {
-  SSA_stepst::iterator it = scoped_end_points.back();
-  cvt_progress = it;
-
-  if (SSA_steps.size() != 0)
-    ++it;
-
-  SSA_steps.erase(it, SSA_steps.end());
+  cvt_progress = scoped_end_points.back();
+  SSA_steps.erase(SSA_steps.begin() + cvt_progress, SSA_steps.end());
 
   conv.pop_ctx();
   scoped_end_points.pop_back();
@@ -511,7 +496,7 @@ std::shared_ptr<symex_targett> runtime_encoded_equationt::clone() const
     "cloned when it contains data");
   auto nthis = std::shared_ptr<runtime_encoded_equationt>(
     new runtime_encoded_equationt(*this));
-  nthis->cvt_progress = nthis->SSA_steps.end();
+  nthis->cvt_progress = 0;
   return nthis;
 }
 
@@ -583,3 +568,151 @@ tvt runtime_encoded_equationt::ask_solver_question(const expr2tc &question)
 
   return final_res;
 }
+
+incremental_equation_convertert::incremental_equation_convertert(
+  smt_convt &conv)
+  : conv(conv)
+{
+  // The committed steps live in their own context, so that they can be
+  // discarded without throwing the solver away.
+  conv.push_ctx();
+  assumpt_ast = conv.convert_ast(gen_true_expr());
+}
+
+bool incremental_equation_convertert::same_step(
+  const stept &prev,
+  const symex_target_equationt::SSA_stept &s)
+{
+  if (prev.type != s.type || prev.ignore != s.ignore)
+    return false;
+
+  // Ignored steps are not encoded at all
+  if (s.ignore)
+    return true;
+
+  return prev.guard == s.guard && prev.lhs == s.lhs && prev.rhs == s.rhs &&
+         prev.cond == s.cond && prev.output_args == s.output_args;
+}
+
+void incremental_equation_convertert::convert(symex_target_equationt &eq)
+{
+  if (suffix_pushed)
+  {
+    conv.pop_ctx();
+    suffix_pushed = false;
+  }
+
+  size_t shared = 0;
+  symex_target_equationt::SSA_stepst::iterator it = eq.SSA_steps.begin();
+  while (shared < previous.size() && it != eq.SSA_steps.end() &&
+         same_step(previous[shared], *it))
+  {
+    ++shared;
+    ++it;
+  }
+
+  if (shared < committed)
+  {
+    // Part of the committed encoding does not belong to this equation.
+    conv.pop_ctx();
+    conv.push_ctx();
+    committed = 0;
+    assumpt_ast = conv.convert_ast(gen_true_expr());
+    assertions.clear();
+    output_count = 0;
+  }
+  reused = committed;
+
+  // Hand the committed encoding over to the steps of this equation.
+  it = eq.SSA_steps.begin();
+  for (size_t i = 0; i < committed; i++, it++)
+  {
+    it->guard_ast = previous[i].guard_ast;
+    it->cond_ast = previous[i].cond_ast;
+    it->converted_output_args = previous[i].converted_output_args;
+  }
+
+  // Steps shared with the previous equation are likely to be shared with
+  // the next one too: commit them.
+  eq.output_count = output_count;
+  for (; committed < shared; committed++, it++)
+  {
+    eq.convert_internal_step(conv, assumpt_ast, assertions, *it);
+    previous[committed].guard_ast = it->guard_ast;
+    previous[committed].cond_ast = it->cond_ast;
+    previous[committed].converted_output_args = it->converted_output_args;
+  }
+  output_count = eq.output_count;
+  previous.resize(committed);
+
+  // Everything else is specific to this equation.
+  conv.push_ctx();
+  suffix_pushed = true;
+
+  smt_astt suffix_assumpt = assumpt_ast;
+  smt_convt::ast_vec suffix_assertions = assertions;
+  for (; it != eq.SSA_steps.end(); it++)
+  {
+    eq.convert_internal_step(conv, suffix_assumpt, suffix_assertions, *it);
+    previous.push_back(
+      {it->type,
+       it->ignore,
+       it->guard,
+       it->lhs,
+       it->rhs,
+       it->cond,
+       it->output_args,
+       nullptr,
+       nullptr,
+       {}});
+  }
+
+  if (!suffix_assertions.empty())
+    conv.assert_ast(conv.make_n_ary_or(suffix_assertions));
+}
+
+symex_claim_viewt::symex_claim_viewt(const symex_target_equationt &eq)
+  : eq(eq), ignored(eq.SSA_steps.size())
+{
+  for (size_t i = 0; i < eq.SSA_steps.size(); i++)
+    ignored[i] = eq.SSA_steps[i].ignore;
+}
+
+const symex_target_equationt::SSA_stept &
+symex_claim_viewt::step(size_t i) const
+{
+  if (!rewritten.empty())
+  {
+    auto it = rewritten.find(i);
+    if (it != rewritten.end())
+      return it->second;
+  }
+  return eq.SSA_steps[i];
+}
+
+void symex_claim_viewt::set_cond(size_t i, const expr2tc &cond)
+{
+  auto it = rewritten.emplace(i, eq.SSA_steps[i]).first;
+  it->second.cond = cond;
+}
+
+symex_target_equationt symex_claim_viewt::materialise(bool keep_ignored) const
+{
+  symex_target_equationt result(eq.ns);
+  result.output_count = eq.output_count;
+
+  size_t kept = 0;
+  for (size_t i = 0; i < size(); i++)
+    if (keep_ignored || !ignored[i])
+      ++kept;
+  result.SSA_steps.reserve(kept);
+
+  for (size_t i = 0; i < size(); i++)
+  {
+    if (!keep_ignored && ignored[i])
+      continue;
+    result.SSA_steps.push_back(step(i));
+    result.SSA_steps.back().ignore = ignored[i];
+  }
+  return result;
+}
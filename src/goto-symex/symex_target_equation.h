@@ -13,6 +13,7 @@
 #include <util/config.h>
 #include <irep2/irep2.h>
 #include <util/namespace.h>
+#include <unordered_map>
 #include <vector>
 
 class symex_target_equationt : public symex_targett
@@ -72,6 +73,11 @@ public:
     const sourcet &source) override;
 
   virtual void convert(smt_convt &smt_conv);
+
+  /// Converts every step like convert(), but asserts none of the
+  /// assertions. Afterwards each assert step's cond_ast holds the property
+  /// it checks, so that claims can be checked one at a time.
+  void convert_without_assertions(smt_convt &smt_conv);
   void convert_internal_step(
     smt_convt &smt_conv,
     smt_astt &assumpt_ast,
@@ -90,8 +96,8 @@ public:
 
     // One stack trace recorded per function activation record. Valid for
     // assignment and assert steps only. In reverse order (most recent in idx
-    // 0).
-    std::vector<stack_framet> stack_trace;
+    // 0). Consecutive steps recorded in the same frame share one trace.
+    std::shared_ptr<const std::vector<stack_framet>> stack_trace;
 
     bool is_assert() const
     {
@@ -126,7 +132,7 @@ public:
 
     // for ASSUME/ASSERT
     expr2tc cond;
-    std::string comment;
+    irep_idt comment;
 
     // for OUTPUT
     std::string format_string;
@@ -166,18 +172,17 @@ public:
     return i;
   }
 
-  typedef std::list<SSA_stept> SSA_stepst;
+  // Steps are stored contiguously: they are only ever appended during symex,
+  // and every later pass (slicing, conversion, trace building) is a linear
+  // walk over them. Do not keep iterators or references to steps across
+  // appends.
+  typedef std::vector<SSA_stept> SSA_stepst;
   SSA_stepst SSA_steps;
 
   SSA_stepst::iterator get_SSA_step(unsigned s)
   {
-    SSA_stepst::iterator it = SSA_steps.begin();
-    for (; s != 0; s--)
-    {
-      assert(it != SSA_steps.end());
-      it++;
-    }
-    return it;
+    assert(s <= SSA_steps.size());
+    return SSA_steps.begin() + s;
   }
 
   void output(std::ostream &out) const;
@@ -189,6 +194,7 @@ public:
   {
     SSA_steps.clear();
     output_count = 0;
+    last_stack_trace.reset();
   }
 
   unsigned int clear_assertions();
@@ -204,6 +210,9 @@ public:
   void pop_ctx() override;
 
 protected:
+  friend class incremental_equation_convertert;
+  friend class symex_claim_viewt;
+
   const namespacet &ns;
 
   bool debug_print;
@@ -211,6 +220,12 @@ protected:
   bool ssa_smt_trace;
   unsigned output_count;
 
+  /// Stack trace of the most recently recorded step, handed out again to the
+  /// following steps as long as they are recorded in the same frame.
+  std::shared_ptr<const std::vector<stack_framet>> last_stack_trace;
+  std::shared_ptr<const std::vector<stack_framet>>
+  share_stack_trace(std::vector<stack_framet> &&stack_trace);
+
 private:
   void debug_print_step(const SSA_stept &step) const;
 };
@@ -237,16 +252,124 @@ public:
   smt_convt &conv;
   std::list<smt_convt::ast_vec> assert_vec_list;
   std::list<smt_astt> assumpt_chain;
-  std::list<SSA_stepst::iterator> scoped_end_points;
-  SSA_stepst::iterator cvt_progress;
+  /// Number of steps converted when each context was pushed
+  std::list<size_t> scoped_end_points;
+  /// Number of steps converted so far
+  size_t cvt_progress;
+};
+
+/**
+ * Converts a sequence of equations into one long-lived solver, re-using the
+ * encoding of the steps each equation shares with its predecessor.
+ *
+ * Successive k-steps of incremental BMC and k-induction re-run symex with a
+ * larger unwinding bound, which reproduces the same SSA steps up to the
+ * first point where the new bound makes a difference. Those steps are
+ * asserted once in a "committed" solver context; only the remaining suffix
+ * is converted in a context on top of it, which is popped again when the
+ * next equation is converted.
+ */
+class incremental_equation_convertert
+{
+public:
+  explicit incremental_equation_convertert(smt_convt &conv);
+
+  /// Converts `eq`; after this call `conv` can be solved and queried for
+  /// a trace of `eq`, exactly as after `eq.convert(conv)`.
+  void convert(symex_target_equationt &eq);
+
+  /// Number of steps whose encoding was re-used by the last convert()
+  size_t reused_steps() const
+  {
+    return reused;
+  }
+
+protected:
+  /// What we remember about one step of the previous equation
+  struct stept
+  {
+    goto_trace_stept::typet type;
+    bool ignore;
+    expr2tc guard, lhs, rhs, cond;
+    std::list<expr2tc> output_args;
+    // Only valid for committed steps
+    smt_astt guard_ast, cond_ast;
+    std::list<expr2tc> converted_output_args;
+  };
+
+  static bool
+  same_step(const stept &prev, const symex_target_equationt::SSA_stept &s);
+
+  smt_convt &conv;
+
+  /// Steps of the previous equation; the first `committed` ones are
+  /// asserted in the committed context.
+  std::vector<stept> previous;
+  size_t committed = 0;
+  size_t reused = 0;
+
+  /// Conversion state at the end of the committed steps
+  smt_astt assumpt_ast;
+  smt_convt::ast_vec assertions;
+  unsigned output_count = 0;
+
+  /// Whether the context holding the previous suffix is still pushed
+  bool suffix_pushed = false;
 };
 
-extern inline bool operator<(
-  const symex_target_equationt::SSA_stepst::const_iterator a,
-  const symex_target_equationt::SSA_stepst::const_iterator b)
+/**
+ * Per-claim view of an equation shared by every claim of multi-property
+ * checking.
+ *
+ * Claims only differ in which steps are sliced away and in the assertions
+ * rewritten for claims that were already verified. Instead of copying the
+ * whole equation for each claim, the view records just that: one "ignore"
+ * bit per step and copies of the few rewritten steps. The steps surviving
+ * the slicers are copied out by materialise() right before solving.
+ */
+class symex_claim_viewt
 {
-  return &(*a) < &(*b);
-}
+public:
+  explicit symex_claim_viewt(const symex_target_equationt &eq);
+
+  size_t size() const
+  {
+    return eq.SSA_steps.size();
+  }
+
+  /// Step `i` as seen by this claim, i.e. including any rewrite
+  const symex_target_equationt::SSA_stept &step(size_t i) const;
+
+  bool is_ignored(size_t i) const
+  {
+    return ignored[i];
+  }
+  void set_ignored(size_t i, bool value)
+  {
+    ignored[i] = value;
+  }
+
+  /// Replaces the condition of step `i` for this claim only
+  void set_cond(size_t i, const expr2tc &cond);
+
+  /// Whether step `i` was rewritten by set_cond()
+  bool is_rewritten(size_t i) const
+  {
+    return !rewritten.empty() && rewritten.count(i);
+  }
+
+  /**
+   * Builds a standalone equation for this claim. Steps ignored in the view
+   * are left out unless `keep_ignored` is set, in which case they are copied
+   * with their ignore flag set; neither affects conversion or traces.
+   */
+  symex_target_equationt materialise(bool keep_ignored = false) const;
+
+protected:
+  const symex_target_equationt &eq;
+  std::vector<bool> ignored;
+  std::unordered_map<size_t, symex_target_equationt::SSA_stept> rewritten;
+};
 
 std::ostream &
 operator<<(std::ostream &out, const symex_target_equationt::SSA_stept &step);
@@ -25,9 +25,11 @@
 #include <boost/mpl/vector.hpp>
 #include <boost/preprocessor/list/adt.hpp>
 #include <boost/preprocessor/list/for_each.hpp>
+#include <atomic>
 #include <cstdarg>
 #include <functional>
 #include <mutex>
+#include <unordered_map>
 #include <util/compiler_defs.h>
 #include <util/crypto_hash.h>
 #include <util/dstring.h>
@@ -181,6 +183,71 @@ class expr2t;
 class constant_array2t;
 class constant_vector2t;
 
+namespace esbmct
+{
+/** Whether the *2tc constructors hash-cons the nodes they build, see
+ *  irep_container::hash_cons(). Off unless --irep2-hash-cons is given. */
+inline std::atomic<bool> hash_consing{false};
+
+/** Process-wide table of the hash-consed type2t or expr2t nodes still alive.
+ *  Nodes are keyed by their crc and only referenced weakly, so the table
+ *  never keeps an expression alive; entries of dead nodes are dropped as
+ *  lookups run into them, and swept whenever a shard has doubled in size. */
+template <class T>
+class hash_cons_tablet
+{
+public:
+  static hash_cons_tablet &get()
+  {
+    static hash_cons_tablet table;
+    return table;
+  }
+
+  /** Returns the live node structurally equal to `node`, or records `node`
+   *  as the representative of its class if there is none.
+   *  @param node Freshly built node, not yet shared with anyone
+   *  @param crc The crc of `node` */
+  std::shared_ptr<T> intern(std::shared_ptr<T> &&node, size_t crc)
+  {
+    shardt &shard = shards[crc % num_shards];
+    std::lock_guard lock(shard.mutex);
+
+    auto [it, end] = shard.nodes.equal_range(crc);
+    while (it != end)
+    {
+      std::shared_ptr<T> known = it->second.lock();
+      if (!known)
+        it = shard.nodes.erase(it);
+      else if (*known == *node)
+        return known;
+      else
+        ++it;
+    }
+
+    node->interned = true;
+    shard.nodes.emplace(crc, node);
+    if (shard.nodes.size() > shard.sweep_at)
+    {
+      for (auto i = shard.nodes.begin(); i != shard.nodes.end();)
+        i = i->second.expired() ? shard.nodes.erase(i) : std::next(i);
+      shard.sweep_at = 2 * shard.nodes.size() + 1024;
+    }
+    return std::move(node);
+  }
+
+private:
+  struct shardt
+  {
+    std::mutex mutex;
+    std::unordered_multimap<size_t, std::weak_ptr<T>> nodes;
+    size_t sweep_at = 1024;
+  };
+
+  static constexpr size_t num_shards = 64;
+  shardt shards[num_shards];
+};
+} // namespace esbmct
+
 /** Reference counted container for expr2t based classes.
  *  This class extends boost shared_ptr's to contain anything that's a subclass
  *  of expr2t. It provides several ways of accessing the contained pointer;
@@ -206,6 +273,13 @@ class constant_vector2t;
  *  std::shared_ptr. However, to the outside the shared_ptr is not accessible
  *  since that would break the const guarantees for operator* and .get() which
  *  this class provides.
+ *
+ *  With esbmct::hash_consing enabled, the *2tc constructors additionally
+ *  unique every node they build (see hash_cons()): structurally equal
+ *  interned nodes are one and the same object, so comparing two of them is a
+ *  pointer comparison and their crc is computed once, up front. An interned
+ *  node is never modified in place; detach() always copies it, even when this
+ *  container is its only owner, and the copy is not interned.
  */
 template <class T>
 class irep_container : private std::shared_ptr<T>
@@ -229,6 +303,30 @@ public:
   {
   }
 
+  /** Wraps a freshly built node, hash-consing it if that is enabled. Used by
+   *  the *2tc constructors. */
+  static irep_container make(std::shared_ptr<T> &&p)
+  {
+    irep_container c(std::move(p));
+    if (esbmct::hash_consing.load(std::memory_order_relaxed))
+      c.hash_cons();
+    return c;
+  }
+
+  /** Replaces the pointee by the unique live node structurally equal to it,
+   *  interning it if there is none. The pointee's subexpressions are left
+   *  alone; the *2tc constructors intern bottom-up. */
+  void hash_cons()
+  {
+    const T *foo = std::shared_ptr<T>::get();
+    if (!foo || foo->interned)
+      return;
+
+    size_t h = crc();
+    std::shared_ptr<T> &self = *this;
+    self = esbmct::hash_cons_tablet<T>::get().intern(std::move(self), h);
+  }
+
   /* provide own definitions for
    *   operator*
    *   operator->
@@ -262,7 +360,7 @@ public:
   {
     detach();
     T *tmp = std::shared_ptr<T>::get();
-    tmp->crc_val = 0;
+    tmp->crc_val.store(0, std::memory_order_relaxed);
     return tmp;
   }
 
@@ -283,7 +381,7 @@ public:
      * From the docs: In multithreaded environment, the value returned by
      * use_count is approximate (typical implementations use a
      * memory_order_relaxed load). */
-    if (this->use_count() == 1)
+    if (this->use_count() == 1 && !std::shared_ptr<T>::get()->interned)
       return; // No point remunging oneself if we're the only user of the ptr.
 
     // Assign-operate ourself into containing a fresh copy of the data. This
@@ -318,11 +416,9 @@ public:
   size_t crc() const
   {
     const T *foo = get();
-    {
-      std::lock_guard<std::mutex> lock(foo->crc_mutex);
-      if (foo->crc_val != 0)
-        return foo->crc_val;
-    }
+    size_t crc = foo->crc_val.load(std::memory_order_relaxed);
+    if (crc != 0)
+      return crc;
 
     return foo->do_crc();
   }
@@ -349,6 +445,10 @@ public:
     if (!a || !b)
       return false;
 
+    // There is only one interned node of each structure
+    if (a->interned && b->interned)
+      return false;
+
     return *a == *b; // different pointees could still compare equal
   }
 
@@ -608,8 +708,13 @@ public:
   // XXX XXX XXX this should be const
   type_ids type_id;
 
-  mutable size_t crc_val;
-  mutable std::mutex crc_mutex;
+  /** Whether this node is the hash-consed representative of its structure,
+   *  see irep_container::hash_cons(). Never copied. */
+  bool interned = false;
+
+  /** Memoized crc, 0 while not computed yet. Racing threads compute the same
+   *  value, so the cache needs no lock. */
+  mutable std::atomic<size_t> crc_val;
 };
 
 /** Fetch identifying name for a type.
@@ -861,11 +966,15 @@ public:
   /** Instance of expr_ids recording tihs exprs type. */
   const expr_ids expr_id;
 
+  /** Whether this node is the hash-consed representative of its structure,
+   *  see irep_container::hash_cons(). Never copied. */
+  bool interned = false;
+
   /** Type of this expr. All exprs have a type. */
   type2tc type;
 
-  mutable size_t crc_val;
-  mutable std::mutex crc_mutex;
+  /** Memoized crc, see type2t::crc_val */
+  mutable std::atomic<size_t> crc_val;
 };
 
 inline bool is_nil_expr(const expr2tc &exp)
@@ -1177,7 +1286,7 @@ protected:
     unsigned int indent) const;
   bool cmp_rec(const base2t &ref) const;
   int lt_rec(const base2t &ref) const;
-  void do_crc_rec() const;
+  void do_crc_rec(size_t &crc) const;
   void hash_rec(crypto_hash &hash) const;
 
   // These methods are specific to expressions rather than types, and are
@@ -1246,8 +1355,9 @@ protected:
     return 0;
   }
 
-  void do_crc_rec() const
+  void do_crc_rec(size_t &crc) const
   {
+    (void)crc;
   }
 
   void hash_rec(crypto_hash &hash) const
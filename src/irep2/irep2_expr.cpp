@@ -131,10 +131,11 @@ expr2t::expr2t(const type2tc &_type, expr_ids id)
 {
 }
 
-expr2t::expr2t(const expr2t &ref) : expr_id(ref.expr_id), type(ref.type)
+expr2t::expr2t(const expr2t &ref)
+  : expr_id(ref.expr_id),
+    type(ref.type),
+    crc_val(ref.crc_val.load(std::memory_order_relaxed))
 {
-  std::lock_guard lock(ref.crc_mutex);
-  crc_val = ref.crc_val;
 }
 
 bool expr2t::operator==(const expr2t &ref) const
@@ -198,9 +199,10 @@ size_t expr2t::crc() const
 
 size_t expr2t::do_crc() const
 {
-  boost::hash_combine(this->crc_val, type->do_crc());
-  boost::hash_combine(this->crc_val, (uint8_t)expr_id);
-  return this->crc_val;
+  size_t crc = 0;
+  boost::hash_combine(crc, type->do_crc());
+  boost::hash_combine(crc, (uint8_t)expr_id);
+  return crc;
 }
 
 void expr2t::hash(crypto_hash &hash) const
@@ -1410,7 +1410,7 @@ public:
   template <typename... Args>                                                  \
   inline expr2tc basename##2tc(Args && ...args)                                \
   {                                                                            \
-    return expr2tc(std::static_pointer_cast<expr2t>(                           \
+    return expr2tc::make(std::static_pointer_cast<expr2t>(                     \
       std::make_shared<basename##2t>(std::forward<Args>(args)...)));           \
   }                                                                            \
   typedef esbmct::expr_methods2<basename##2t, superclass, superclass::traits>  \
@@ -176,18 +176,17 @@ size_t
 esbmct::irep_methods2<derived, baseclass, traits, enable, fields>::do_crc()
   const
 {
-  std::lock_guard<std::mutex> lock(this->crc_mutex);
-  if (this->crc_val != 0)
-    return this->crc_val;
+  size_t crc = this->crc_val.load(std::memory_order_relaxed);
+  if (crc != 0)
+    return crc;
 
   // Starting from 0, pass a crc value through all the sub-fields of this
-  // expression. Store it into crc_val.
-  assert(this->crc_val == 0);
+  // expression. Store it into crc_val; if another thread got there first,
+  // it stored the same value.
+  do_crc_rec(crc); // _includes_ type_id / expr_id
 
-  do_crc_rec(); // _includes_ type_id / expr_id
-
-  // Finally, combine the crc of this expr with the input , and return
-  return this->crc_val;
+  this->crc_val.store(crc, std::memory_order_relaxed);
+  return crc;
 }
 
 template <
@@ -283,15 +282,15 @@ template <
   typename enable,
   typename fields>
 void esbmct::irep_methods2<derived, baseclass, traits, enable, fields>::
-  do_crc_rec() const
+  do_crc_rec(size_t &crc) const
 {
   const derived *derived_this = static_cast<const derived *>(this);
   auto m_ptr = membr_ptr::value;
 
   size_t tmp = do_type_crc(derived_this->*m_ptr);
-  boost::hash_combine(this->crc_val, tmp);
+  boost::hash_combine(crc, tmp);
 
-  superclass::do_crc_rec();
+  superclass::do_crc_rec(crc);
 }
 
 template <
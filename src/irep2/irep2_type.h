@@ -297,7 +297,7 @@ public:
   template <typename... Args>                                                  \
   inline type2tc basename##_type2tc(Args &&...args)                            \
   {                                                                            \
-    return type2tc(std::static_pointer_cast<type2t>(                           \
+    return type2tc::make(std::static_pointer_cast<type2t>(                     \
       std::make_shared<basename##_type2t>(std::forward<Args>(args)...)));      \
   }                                                                            \
   typedef esbmct::                                                             \
@@ -131,37 +131,46 @@ bool value_sett::make_union(const value_sett::valuest &new_values, bool keepnew)
 {
   bool result = false;
 
+  // Only entries outside of the subtrees both value sets still share can
+  // contribute anything. Collect them first, as merging modifies the trie.
+  std::vector<const valuest::value_type *> unshared;
+  values.for_each_unshared(
+    new_values, [&unshared](const valuest::value_type &new_value) {
+      unshared.push_back(&new_value);
+    });
+
   // Iterate over all new values; if they're in the current value set, merge
   // them. If not, only merge it in if keepnew is true.
-  for (const auto &new_value : new_values)
+  for (const valuest::value_type *new_value : unshared)
   {
-    valuest::iterator it2 = values.find(new_value.first);
+    const entryt &new_e = new_value->second;
+    const entryt *e = values.find(new_value->first);
 
     // If the new variable isn't in this set
-    if (it2 == values.end())
+    if (!e)
     {
       // We always track these when merging value sets, as these store data
       // that's transferred back and forth between function calls. So, the
       // variables not existing in the state we're merging into is irrelevant.
       if (
-        has_prefix(
-          id2string(new_value.second.identifier),
-          "value_set::dynamic_object") ||
-        new_value.second.identifier == "value_set::return_value" || keepnew)
+        has_prefix(id2string(new_e.identifier), "value_set::dynamic_object") ||
+        new_e.identifier == "value_set::return_value" || keepnew)
       {
-        values.insert(new_value);
+        values.insert(*new_value);
         result = true;
       }
 
       continue;
     }
 
-    // The variable was in this set, merge the values.
-    entryt &e = it2->second;
-    const entryt &new_e = new_value.second;
-
-    if (make_union(e.object_map, new_e.object_map))
+    // The variable was in this set, merge the values. Only unshare the entry
+    // when that adds something to it.
+    object_mapt merged = e->object_map;
+    if (make_union(merged, new_e.object_map))
+    {
+      values.find_mutable(new_value->first)->object_map = std::move(merged);
       result = true;
+    }
   }
 
   return result;
@@ -474,11 +483,11 @@ void value_sett::get_value_set_rec(
     const std::string name = "value_set::dynamic_object" + idnum + suffix;
 
     // look it up
-    valuest::const_iterator v_it = values.find(name);
+    const entryt *e = values.find(name);
 
-    if (v_it != values.end())
+    if (e)
     {
-      make_union(dest, v_it->second.object_map);
+      make_union(dest, e->object_map);
       return;
     }
   }
@@ -538,7 +547,7 @@ void value_sett::get_value_set_rec(
 
     // Look up this symbol, with the given suffix to distinguish any arrays or
     // members we've picked out of it at a higher level.
-    valuest::const_iterator v_it = values.find(sym.get_symbol_name() + suffix);
+    const entryt *e = values.find(sym.get_symbol_name() + suffix);
 
     if (sym.rlevel == symbol2t::renaming_level::level1_global)
       assert(sym.level1_num == 0);
@@ -552,9 +561,9 @@ void value_sett::get_value_set_rec(
      */
 
     // If it points at things, put those things into the destination object map.
-    if (v_it != values.end())
+    if (e)
     {
-      make_union(dest, v_it->second.object_map);
+      make_union(dest, e->object_map);
       return;
     }
   }
@@ -1193,9 +1202,10 @@ void value_sett::do_free(const expr2tc &op)
     }
   }
 
-  // mark these as 'may be invalid'
-  // this, unfortunately, destroys the sharing
-  for (auto &value : values)
+  // mark these as 'may be invalid'; only the entries that change are
+  // unshared, once the walk over the trie is done
+  std::vector<std::pair<irep_idt, object_mapt>> updates;
+  for (const auto &value : values)
   {
     object_mapt new_object_map;
 
@@ -1229,8 +1239,11 @@ void value_sett::do_free(const expr2tc &op)
     }
 
     if (changed)
-      value.second.object_map = new_object_map;
+      updates.emplace_back(value.first, std::move(new_object_map));
   }
+
+  for (auto &update : updates)
+    values.find_mutable(update.first)->object_map = std::move(update.second);
 }
 
 void value_sett::assign_rec(
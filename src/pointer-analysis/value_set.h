@@ -7,6 +7,7 @@
 #include <util/mp_arith.h>
 #include <util/namespace.h>
 #include <util/numbering.h>
+#include <util/persistent_map.h>
 #include <util/type_byte_size.h>
 
 /** Code for tracking "value sets" across assignments in ESBMC.
@@ -245,8 +246,10 @@ public:
 
   /** Type of the value-set containing structure. A hash map mapping variables
    *  to an entryt, storing the value set of objects a variable might point
-   *  at. */
-  typedef std::unordered_map<irep_idt, entryt, irep_id_hash> valuest;
+   *  at. It is persistent: symex copies value sets at every branch, merge
+   *  point and interleaving, and those copies share all entries until either
+   *  side modifies them. */
+  typedef persistent_mapt<irep_idt, entryt, irep_id_hash> valuest;
 
   /** Get the natural alignment unit of a reference to e. I don't know a more
    *  appropriate term, but if we were to have an offset into e, then what is
@@ -412,7 +415,7 @@ public:
    *  @return True when the erase succeeds, false otherwise. */
   bool erase(const std::string &name)
   {
-    return (values.erase(name) == 1);
+    return values.erase(name);
   }
 
   /** Get the set of things that an expression might point at. Interprets the
@@ -447,12 +450,15 @@ public:
    *  given record already exists. */
   void add_var(const std::string &id, const std::string &suffix)
   {
-    get_entry(id, suffix);
+    add_var(entryt(id, suffix));
   }
 
   void add_var(const entryt &e)
   {
-    get_entry(e.identifier, e.suffix);
+    // Unlike get_entry, leave an existing record shared
+    irep_idt index = id2string(e.identifier) + e.suffix;
+    if (!values.find(index))
+      values.insert(index, e);
   }
 
   /** Delete the value set for the given variable name and suffix. */
@@ -474,10 +480,7 @@ public:
   {
     std::string index = id2string(e.identifier) + e.suffix;
 
-    std::pair<valuest::iterator, bool> r =
-      values.insert(std::pair<irep_idt, entryt>(index, e));
-
-    return r.first->second;
+    return *values.insert(index, e).first;
   }
 
   /** Add a value set for each variable in the given list. */
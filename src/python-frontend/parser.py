@@ -11,16 +11,27 @@ if not PY3:
 
 import ast
 import importlib.util
+import io
 import json
 import os
 import glob
 import base64
+import functools
+import hashlib
+import signal
+import socket
+import traceback
 from preprocessor import Preprocessor
 
 
 def check_usage():
+    if len(sys.argv) == 3 and sys.argv[1] == "--serve":
+        return
+    if len(sys.argv) == 5 and sys.argv[3] == "--cache-dir":
+        return
     if len(sys.argv) != 3:
-        print("Usage: python astgen.py <file path> <output directory>")
+        print("Usage: python astgen.py <file path> <output directory> [--cache-dir <directory>]")
+        print("       python astgen.py --serve <socket path>")
         sys.exit(2)
 
 def is_imported_model(module_name):
@@ -117,22 +128,39 @@ def process_imports(node, output_dir):
 
     # Generate JSON file for imported elements
     try:
-        with open(filename, "r") as source:
-            tree = ast.parse(source.read())
-            generate_ast_json(tree, filename, imported_elements, output_dir)
+        generate_cached_ast_json(filename, filename, imported_elements, output_dir)
     except UnicodeDecodeError:
         pass
 
 
-def generate_ast_json(tree, python_filename, elements_to_import, output_dir):
+# Directory of the AST cache, if enabled with --cache-dir
+cache_dir = None
+
+
+@functools.lru_cache(maxsize=None)
+def cache_version():
     """
-    Generate AST JSON from the given Python AST tree.
+    Everything besides the source that determines the JSON of a module: this
+    script, the interpreter and the ast2json module.
+    """
+    ast2json_module = import_module_by_name("ast2json", "")
+    h = hashlib.sha256()
+    with open(__file__, "rb") as script:
+        h.update(script.read())
+    h.update(sys.version.encode())
+    h.update(str(getattr(ast2json_module, "__version__", "")).encode())
+    h.update(str(getattr(ast2json_module, "__file__", "")).encode())
+    return h.hexdigest()
+
+
+def ast_to_json_text(tree, elements_to_import):
+    """
+    Convert the given Python AST tree to JSON text, without the filename and
+    output directory, which generate_ast_json adds.
 
     Parameters:
         - tree: The Python AST tree.
-        - python_filename: The filename of the Python source file.
         - elements_to_import: The elements (classes or functions) to be imported from the module.
-        - output_dir: The directory to save the generated JSON file.
     """
 
     # Filter elements to be imported from the module
@@ -148,8 +176,73 @@ def generate_ast_json(tree, python_filename, elements_to_import, output_dir):
     # Convert AST to JSON
     ast2json_module = import_module_by_name("ast2json", "")
     ast_json = ast2json_module.ast2json(ast.Module(body=filtered_nodes) if filtered_nodes else tree)
-    ast_json["filename"] = python_filename
-    ast_json["ast_output_dir"] = output_dir
+    return json.dumps(ast_json, ensure_ascii=False)
+
+
+def generate_cached_ast_json(source_path, python_filename, elements_to_import, output_dir):
+    """
+    Like generate_ast_json on the parsed contents of source_path, but reuse
+    the JSON of an earlier run on the same contents if --cache-dir is given.
+    Only suitable for modules that are not preprocessed, i.e. imported modules
+    and models.
+
+    Raises UnicodeDecodeError if the source is not text.
+    """
+    with open(source_path, "rb") as source:
+        contents = source.read()
+    text = contents.decode()
+
+    cache_file = None
+    if cache_dir is not None:
+        names = sorted(e.name for e in elements_to_import or [])
+        h = hashlib.sha256(cache_version().encode())
+        h.update(contents)
+        h.update(repr(names).encode())
+        cache_file = os.path.join(cache_dir, h.hexdigest() + ".json")
+        try:
+            with open(cache_file, "r", encoding="utf-8") as cached:
+                write_ast_json(cached.read(), python_filename, output_dir)
+            return
+        except OSError:
+            pass
+
+    json_text = ast_to_json_text(ast.parse(text), elements_to_import)
+
+    if cache_file is not None:
+        # Write atomically, other runs may read the cache concurrently
+        tmp_file = "{}.{}.tmp".format(cache_file, os.getpid())
+        try:
+            with open(tmp_file, "w", encoding="utf-8") as cached:
+                cached.write(json_text)
+            os.replace(tmp_file, cache_file)
+        except OSError:
+            pass
+
+    write_ast_json(json_text, python_filename, output_dir)
+
+
+def generate_ast_json(tree, python_filename, elements_to_import, output_dir):
+    """
+    Generate AST JSON from the given Python AST tree.
+
+    Parameters:
+        - tree: The Python AST tree.
+        - python_filename: The filename of the Python source file.
+        - elements_to_import: The elements (classes or functions) to be imported from the module.
+        - output_dir: The directory to save the generated JSON file.
+    """
+    write_ast_json(ast_to_json_text(tree, elements_to_import), python_filename, output_dir)
+
+
+def write_ast_json(json_text, python_filename, output_dir):
+    """
+    Write the JSON text of an AST, adding the filename and output directory.
+    """
+    assert json_text.startswith("{") and json_text != "{}"
+    json_text = '{{"filename": {}, "ast_output_dir": {}, {}'.format(
+        json.dumps(python_filename, ensure_ascii=False),
+        json.dumps(output_dir, ensure_ascii=False),
+        json_text[1:])
 
     # Construct JSON filename
     if python_filename.endswith('__init__.py'):
@@ -166,8 +259,8 @@ def generate_ast_json(tree, python_filename, elements_to_import, output_dir):
 
     # Write AST JSON to file
     try:
-        with open(json_filename, "w") as json_file:
-            json.dump(ast_json, json_file, indent=4, ensure_ascii=False)
+        with open(json_filename, "w", encoding="utf-8") as json_file:
+            json_file.write(json_text)
     except Exception as e:
         print("Error writing JSON file: {}".format(e))
 
@@ -222,16 +315,17 @@ def detect_and_process_submodules(node, processed_submodules, output_dir):
                     if file.endswith('.py'):
                         full_path = os.path.join(root, file)
                         try:
-                            with open(full_path, "r") as f:
-                                tree = ast.parse(f.read())
-                                generate_ast_json(tree, full_path, None, output_dir + "/" + base_module)
+                            generate_cached_ast_json(full_path, full_path, None, output_dir + "/" + base_module)
                         except UnicodeDecodeError:
                             continue
 
-def main():
-    check_usage()
-    filename = sys.argv[1]
-    output_dir = sys.argv[2]
+def parse_file(filename, output_dir):
+    """
+    Generate the JSON ASTs of the given file, of the modules it imports and
+    of the models, into output_dir.
+    """
+    global import_aliases
+    import_aliases = {}
 
     # Add the script directory to the import search path
     sys.path.append(os.path.dirname(filename))
@@ -275,10 +369,114 @@ def main():
         if is_imported_model(module_name):
             continue;
 
-        with open(python_file) as model:
-            model_tree = ast.parse(model.read())
-            # Generate JSON from AST for the memory models.
-            generate_ast_json(model_tree, filename, None, output_dir)
+        # Generate JSON from AST for the memory models.
+        generate_cached_ast_json(python_file, filename, None, output_dir)
+
+
+def handle_request(connection):
+    """
+    Serve one request of the form {"file": ..., "output_dir": ...,
+    "cache_dir": ..., "cwd": ...} on its own line, replying with
+    {"code": <exit code>, "output": <what was printed>, "errors": <what was
+    printed to stderr>}. Runs in a forked child, so whatever the parse
+    imports or modifies is gone afterwards.
+    """
+    global cache_dir
+
+    code = 0
+    output = io.StringIO()
+    errors = io.StringIO()
+    sys.stdout = output
+    sys.stderr = errors
+    try:
+        with connection.makefile("r", encoding="utf-8") as requests:
+            request = json.loads(requests.readline())
+        os.chdir(request["cwd"])
+        cache_dir = request.get("cache_dir")
+        if cache_dir is not None:
+            os.makedirs(cache_dir, exist_ok=True)
+        parse_file(request["file"], request["output_dir"])
+    except SystemExit as e:
+        # Same exit status as the interpreter would give
+        if e.code is None:
+            code = 0
+        elif isinstance(e.code, int):
+            code = e.code
+        else:
+            print(e.code, file=errors)
+            code = 1
+    except BaseException:
+        traceback.print_exc(file=errors)
+        code = 1
+    sys.stdout = sys.__stdout__
+    sys.stderr = sys.__stderr__
+
+    reply = json.dumps({
+        "code": code,
+        "output": output.getvalue(),
+        "errors": errors.getvalue()
+    }) + "\n"
+    connection.sendall(reply.encode("utf-8"))
+    connection.close()
+
+
+def serve(socket_path, idle_timeout=600):
+    """
+    Resident parser: wait for requests on a UNIX socket, forking a child for
+    each of them, so that none pays for the interpreter startup and imports.
+    Exits after idle_timeout seconds without requests.
+    """
+    server = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    try:
+        server.bind(socket_path)
+    except OSError:
+        # Either another server is running, or a stale socket was left behind
+        probe = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        try:
+            probe.connect(socket_path)
+            probe.close()
+            return
+        except OSError:
+            os.unlink(socket_path)
+            server.bind(socket_path)
+    server.listen(16)
+    server.settimeout(idle_timeout)
+
+    # Load what every request needs once, and let the kernel reap children
+    cache_version()
+    signal.signal(signal.SIGCHLD, signal.SIG_IGN)
+
+    try:
+        while True:
+            try:
+                connection, _ = server.accept()
+            except socket.timeout:
+                break
+            if os.fork() == 0:
+                server.close()
+                handle_request(connection)
+                os._exit(0)
+            connection.close()
+    finally:
+        # The cache directory may have been removed in the meantime
+        try:
+            os.unlink(socket_path)
+        except FileNotFoundError:
+            pass
+
+
+def main():
+    global cache_dir
+    check_usage()
+
+    if sys.argv[1] == "--serve":
+        serve(sys.argv[2])
+        return
+
+    if len(sys.argv) == 5:
+        cache_dir = sys.argv[4]
+        os.makedirs(cache_dir, exist_ok=True)
+    parse_file(sys.argv[1], sys.argv[2])
 
 
 if __name__ == "__main__":
@@ -8,12 +8,25 @@
 #include <util/c_expr2string.h>
 #include <c2goto/cprover_library.h>
 
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <functional>
+#include <iostream>
+#include <thread>
 
 #include <boost/filesystem.hpp>
 #include <boost/process.hpp>
 
+#ifndef _WIN32
+#  include <cerrno>
+#  include <sys/socket.h>
+#  include <sys/stat.h>
+#  include <sys/un.h>
+#  include <unistd.h>
+#endif
+
 namespace bp = boost::process;
 namespace fs = boost::filesystem;
 
@@ -48,6 +61,160 @@ static const std::string &dump_python_script()
   return p.path();
 }
 
+#ifndef _WIN32
+/// Returns the directory of `cache_dir` holding the resident parser sockets
+/// of the current user, creating it if needed. Only that user may create
+/// entries in it, so no one else can bind a socket we would then talk to.
+/// @return empty if the directory is not ours or is open to other users
+static std::string resident_parser_dir(const std::string &cache_dir)
+{
+  const std::string dir =
+    (fs::path(cache_dir) / fmt::format("parser-{}", geteuid())).string();
+  boost::system::error_code ec;
+  fs::create_directories(cache_dir, ec);
+  if (mkdir(dir.c_str(), 0700) != 0 && errno != EEXIST)
+    return "";
+
+  struct stat st;
+  if (
+    lstat(dir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode) ||
+    st.st_uid != geteuid() || (st.st_mode & 077) != 0)
+  {
+    log_warning(
+      "Not using a resident Python parser: {} is not private to this user",
+      dir);
+    return "";
+  }
+  return dir;
+}
+
+/// Sends `request` to the resident parser listening on `socket_path`, prints
+/// what the parser printed and stores its exit code in `code`.
+/// @return true if no resident parser of ours answered
+static bool request_resident_parser(
+  const std::string &socket_path,
+  const nlohmann::json &request,
+  int &code)
+{
+  struct stat st;
+  if (
+    lstat(socket_path.c_str(), &st) != 0 || !S_ISSOCK(st.st_mode) ||
+    st.st_uid != geteuid())
+    return true;
+
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, socket_path.c_str());
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0)
+    return true;
+  if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0)
+  {
+    close(fd);
+    return true;
+  }
+
+  const std::string line = request.dump() + "\n";
+  for (size_t sent = 0; sent < line.size();)
+  {
+    ssize_t n = write(fd, line.data() + sent, line.size() - sent);
+    if (n <= 0)
+    {
+      close(fd);
+      return true;
+    }
+    sent += n;
+  }
+
+  std::string reply;
+  char buf[4096];
+  for (ssize_t n; (n = read(fd, buf, sizeof(buf))) > 0;)
+    reply.append(buf, n);
+  close(fd);
+
+  nlohmann::json r = nlohmann::json::parse(reply, nullptr, false);
+  if (r.is_discarded() || !r.contains("code"))
+    return true;
+
+  std::cout << r["output"].get<std::string>() << std::flush;
+  std::cerr << r.value("errors", "") << std::flush;
+  code = r["code"].get<int>();
+  log_debug(
+    "python",
+    "Parsed {} in the resident parser",
+    request["file"].get<std::string>());
+  return false;
+}
+
+/// Runs parser.py in the resident parser process kept for `cache_dir`,
+/// starting that process if there is none yet. It serves every esbmc run
+/// with the same interpreter and parser, until it has been idle for a while.
+/// @param output_dir Where the scripts were dumped and the ASTs are written
+/// @return true if the resident parser could not be used
+static bool parse_with_resident_parser(
+  const std::string &python_exec,
+  const std::string &path,
+  const std::string &output_dir,
+  const std::string &cache_dir,
+  int &code)
+{
+  // One parser per interpreter, module search path and version of the
+  // scripts it has loaded
+  std::string key = python_exec;
+  if (const char *pythonpath = getenv("PYTHONPATH"))
+    key += pythonpath;
+  for (const char *script : {"parser.py", "preprocessor.py"})
+  {
+    std::ifstream in(
+      (fs::path(output_dir) / script).string(), std::ios::binary);
+    key.append(std::istreambuf_iterator<char>(in), {});
+  }
+  const std::string socket_dir = resident_parser_dir(cache_dir);
+  if (socket_dir.empty())
+    return true;
+  const std::string socket_path =
+    (fs::path(socket_dir) /
+     fmt::format("parser-{:016x}.sock", std::hash<std::string>{}(key)))
+      .string();
+  if (socket_path.size() >= sizeof(sockaddr_un::sun_path))
+  {
+    log_debug("python", "Socket path too long: {}", socket_path);
+    return true;
+  }
+
+  nlohmann::json request = {
+    {"file", fs::absolute(path).string()},
+    {"output_dir", output_dir},
+    {"cache_dir", cache_dir},
+    {"cwd", fs::current_path().string()}};
+
+  if (!request_resident_parser(socket_path, request, code))
+    return false;
+
+  // Start one; it outlives this run, so it must not hold on to our output
+  log_debug("python", "Starting resident parser on {}", socket_path);
+  bp::spawn(
+    python_exec,
+    (fs::path(output_dir) / "parser.py").string(),
+    "--serve",
+    socket_path,
+    bp::std_in < bp::null,
+    bp::std_out > bp::null,
+    bp::std_err > bp::null);
+
+  for (int i = 0; i < 200; i++)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    if (!request_resident_parser(socket_path, request, code))
+      return false;
+  }
+
+  log_warning("Could not start a resident Python parser, running it directly");
+  return true;
+}
+#endif
+
 languaget *new_python_language()
 {
   return new python_languaget;
@@ -88,15 +255,37 @@ bool python_languaget::parse(const std::string &path)
     exit(1);
   }
 
-  // Create a child process to execute Python
-  bp::child process(python_exec_path, args);
+  std::string cache_dir = config.options.get_option("python-cache-dir");
+  if (!cache_dir.empty())
+    cache_dir = fs::absolute(cache_dir).string();
+
+  int exit_code;
+  bool run_directly = true;
+#ifndef _WIN32
+  if (!cache_dir.empty())
+    run_directly = parse_with_resident_parser(
+      python_exec_path.string(), path, ast_output_dir, cache_dir, exit_code);
+#endif
 
-  // Wait for execution
-  process.wait();
+  if (run_directly)
+  {
+    if (!cache_dir.empty())
+    {
+      args.push_back("--cache-dir");
+      args.push_back(cache_dir);
+    }
+
+    // Create a child process to execute Python
+    bp::child process(python_exec_path, args);
+
+    // Wait for execution
+    process.wait();
+    exit_code = process.exit_code();
+  }
 
   // parser.py execution failed
-  if (process.exit_code())
-    exit(process.exit_code());
+  if (exit_code)
+    exit(exit_code);
 
   std::stringstream script_path;
   script_path << ast_output_dir << "/" << script.stem().string() << ".json";
@@ -10,6 +10,11 @@ void bitwuzla_error_handler(const char *msg)
   abort();
 }
 
+static int32_t bitwuzla_terminate(void *state)
+{
+  return static_cast<std::atomic<bool> *>(state)->load();
+}
+
 smt_convt *create_new_bitwuzla_solver(
   const optionst &options,
   const namespacet &ns,
@@ -37,6 +42,7 @@ bitwuzla_convt::bitwuzla_convt(const namespacet &ns, const optionst &options)
   bitwuzla_set_option(bitw_options, BITWUZLA_OPT_PRODUCE_MODELS, 1);
   bitwuzla_set_abort_callback(bitwuzla_error_handler);
   bitw = bitwuzla_new(bitw_term_manager, bitw_options);
+  bitwuzla_set_termination_callback(bitw, bitwuzla_terminate, &terminate);
 }
 
 bitwuzla_convt::~bitwuzla_convt()
@@ -67,6 +73,7 @@ smt_convt::resultt bitwuzla_convt::dec_solve()
 {
   pre_solve();
 
+  terminate = false;
   BitwuzlaResult result = bitwuzla_check_sat(bitw);
 
   if (result == BITWUZLA_SAT)
@@ -78,6 +85,12 @@ smt_convt::resultt bitwuzla_convt::dec_solve()
   return P_ERROR;
 }
 
+bool bitwuzla_convt::interrupt()
+{
+  terminate = true;
+  return true;
+}
+
 const std::string bitwuzla_convt::solver_text()
 {
   std::string ss = "Bitwuzla ";
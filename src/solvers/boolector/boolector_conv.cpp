@@ -9,6 +9,11 @@ void error_handler(const char *msg)
   abort();
 }
 
+static int32_t boolector_terminate(void *state)
+{
+  return static_cast<std::atomic<bool> *>(state)->load();
+}
+
 smt_convt *create_new_boolector_solver(
   const optionst &options,
   const namespacet &ns,
@@ -38,6 +43,7 @@ boolector_convt::boolector_convt(const namespacet &ns, const optionst &options)
   if (options.get_bool_option("smt-during-symex"))
     boolector_set_opt(btor, BTOR_OPT_INCREMENTAL, 1);
   boolector_set_abort(error_handler);
+  boolector_set_term(btor, boolector_terminate, &terminate);
 }
 
 boolector_convt::~boolector_convt()
@@ -65,6 +71,7 @@ smt_convt::resultt boolector_convt::dec_solve()
 {
   pre_solve();
 
+  terminate = false;
   int result = boolector_sat(btor);
 
   if (result == BOOLECTOR_SAT)
@@ -76,6 +83,12 @@ smt_convt::resultt boolector_convt::dec_solve()
   return P_ERROR;
 }
 
+bool boolector_convt::interrupt()
+{
+  terminate = true;
+  return true;
+}
+
 const std::string boolector_convt::solver_text()
 {
   std::string ss = "Boolector ";
@@ -1,6 +1,7 @@
 #ifndef _ESBMC_SOLVERS_BOOLECTOR_BOOLECTOR_CONV_H_
 #define _ESBMC_SOLVERS_BOOLECTOR_BOOLECTOR_CONV_H_
 
+#include <atomic>
 #include <cstdio>
 #include <solvers/smt/smt_conv.h>
 #include <irep2/irep2.h>
@@ -29,6 +30,7 @@ public:
   void push_ctx() override;
   void pop_ctx() override;
   resultt dec_solve() override;
+  bool interrupt() override;
   const std::string solver_text() override;
 
   void assert_ast(smt_astt a) override;
@@ -108,6 +110,9 @@ public:
   Btor *btor;
 
   symtabt symtable;
+
+  /// Polled by the solver's termination callback during dec_solve
+  std::atomic<bool> terminate{false};
 };
 
 #endif /* _ESBMC_SOLVERS_BOOLECTOR_BOOLECTOR_CONV_H_ */
@@ -99,7 +99,6 @@ expr2tc cvc5_convt::get_array_elem(
   smt_astt tmpast = mk_smt_bv(BigInt(index), mk_bv_sort(orig_w));
   auto const *tmpa = to_solver_smt_ast<cvc5_smt_ast>(tmpast);
   cvc5::Term e = slv.mkTerm(cvc5::Kind::SELECT, {carray->a, tmpa->a});
-  delete tmpast;
 
   return get_by_ast(subtype, new_ast(e, convert_sort(subtype)));
 }
@@ -151,7 +151,7 @@ public:
 
   inline bitblast_smt_ast *new_ast(smt_sortt ressort)
   {
-    return new bitblast_smt_ast(this, ressort);
+    return make_ast<bitblast_smt_ast>(this, ressort);
   }
 
   // Members
@@ -40,6 +40,18 @@ public:
   smt_ast(smt_convt *ctx, smt_sortt s);
   virtual ~smt_ast() = default;
 
+  /** ASTs live in the arena of their context and are only created with
+   *  smt_convt::make_ast. They are destroyed when the context is popped, and
+   *  their memory is released with the arena rather than deleted. */
+  static void *operator new(std::size_t) = delete;
+  static void *operator new(std::size_t, void *p) noexcept
+  {
+    return p;
+  }
+  static void operator delete(void *) noexcept
+  {
+  }
+
   // "this" is the true operand.
   virtual smt_astt ite(smt_convt *ctx, smt_astt cond, smt_astt falseop) const;
 
@@ -0,0 +1,122 @@
+#ifndef SOLVERS_SMT_SMT_AST_ARENA_H_
+#define SOLVERS_SMT_SMT_AST_ARENA_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/** Bump allocator for the smt_asts of one solver converter.
+ *  Memory is handed out from a list of chunks of growing size and is never
+ *  freed object by object: push() marks the current position, and pop()
+ *  releases everything allocated since the matching push() at once. Released
+ *  chunks are kept and reused by later allocations, so that a context which
+ *  is pushed and popped repeatedly does not go back to the system allocator.
+ *
+ *  The arena only deals with memory; the owner of the objects is responsible
+ *  for running their destructors before releasing them.
+ *  @see smt_convt::make_ast */
+class smt_ast_arenat
+{
+public:
+  smt_ast_arenat() = default;
+  smt_ast_arenat(const smt_ast_arenat &) = delete;
+  smt_ast_arenat &operator=(const smt_ast_arenat &) = delete;
+
+  /** @return uninitialised memory for an object of the given size and
+   *  alignment, valid until the enclosing context is popped */
+  void *allocate(size_t size, size_t align)
+  {
+    assert(align <= alignof(std::max_align_t) && (align & (align - 1)) == 0);
+
+    size_t offset = (used + align - 1) & ~(align - 1);
+    if (chunks.empty() || offset + size > chunks[current].size)
+    {
+      next_chunk(size);
+      offset = 0;
+    }
+
+    used = offset + size;
+    return chunks[current].data.get() + offset;
+  }
+
+  /** Marks the current position, for the next pop() to return to */
+  void push()
+  {
+    marks.push_back({current, used});
+  }
+
+  /** Releases everything allocated since the matching push() */
+  void pop()
+  {
+    assert(!marks.empty());
+    current = marks.back().chunk;
+    used = marks.back().used;
+    marks.pop_back();
+  }
+
+  /** Releases everything, keeping the chunks for reuse */
+  void clear()
+  {
+    current = 0;
+    used = 0;
+    marks.clear();
+  }
+
+  /** @return bytes held from the system allocator */
+  size_t capacity() const
+  {
+    size_t total = 0;
+    for (const chunkt &c : chunks)
+      total += c.size;
+    return total;
+  }
+
+protected:
+  struct chunkt
+  {
+    std::unique_ptr<char[]> data;
+    size_t size;
+  };
+
+  struct markt
+  {
+    size_t chunk;
+    size_t used;
+  };
+
+  /** Moves on to a chunk with room for at least `size` bytes, reusing the
+   *  next released chunk if it is large enough */
+  void next_chunk(size_t size)
+  {
+    size_t next = chunks.empty() ? 0 : current + 1;
+    if (next < chunks.size() && chunks[next].size >= size)
+    {
+      current = next;
+      used = 0;
+      return;
+    }
+
+    // Double the chunk size each time, so that the number of chunks stays
+    // logarithmic in the size of the formula
+    size_t chunk_size = chunks.empty() ? first_chunk_size
+                                       : 2 * chunks[current].size;
+    chunk_size = std::max(chunk_size, size);
+    chunks.insert(
+      chunks.begin() + next,
+      chunkt{std::unique_ptr<char[]>(new char[chunk_size]), chunk_size});
+    current = next;
+    used = 0;
+  }
+
+  static constexpr size_t first_chunk_size = 64 * 1024;
+
+  std::vector<chunkt> chunks;
+  /** The chunk being allocated from, and how much of it is in use */
+  size_t current = 0;
+  size_t used = 0;
+  std::vector<markt> marks;
+};
+
+#endif /* SOLVERS_SMT_SMT_AST_ARENA_H_ */
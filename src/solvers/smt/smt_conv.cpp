@@ -133,10 +133,13 @@ void smt_convt::set_fp_conv(fp_convt *iface)
 
 void smt_convt::delete_all_asts()
 {
-  // Erase all the remaining asts in the live ast vector.
-  for (auto *ast : live_asts)
-    delete ast;
+  // Destroy all the remaining asts in the live ast vector, newest first, and
+  // release their memory with the arena.
+  for (auto it = live_asts.rbegin(); it != live_asts.rend(); ++it)
+    (*it)->~smt_ast();
   live_asts.clear();
+  live_asts_sizes.clear();
+  ast_arena.clear();
 }
 
 void smt_convt::smt_post_init()
@@ -175,6 +178,7 @@ void smt_convt::push_ctx()
   renumber_map.push_back(renumber_map.back());
 
   live_asts_sizes.push_back(live_asts.size());
+  ast_arena.push();
 
   ctx_level++;
 }
@@ -213,14 +217,14 @@ void smt_convt::pop_ctx()
 
   ctx_level--;
 
-  // Go through all the asts created since the last push and delete them.
+  // Go through all the asts created since the last push and destroy them.
+  for (size_t idx = live_asts.size(); idx > live_asts_sizes.back(); idx--)
+    live_asts[idx - 1]->~smt_ast();
 
-  for (unsigned int idx = live_asts_sizes.back(); idx < live_asts.size(); idx++)
-    delete live_asts[idx];
-
-  // And reset the storage back to that point.
+  // And reset the storage back to that point, releasing their memory.
   live_asts.resize(live_asts_sizes.back());
   live_asts_sizes.pop_back();
+  ast_arena.pop();
 
   array_api->pop_array_ctx();
   tuple_api->pop_tuple_ctx();
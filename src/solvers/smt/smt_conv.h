@@ -9,6 +9,7 @@
 #include <mutex>
 #include <solvers/prop/literal.h>
 #include <solvers/prop/pointer_logic.h>
+#include <solvers/smt/smt_ast_arena.h>
 #include <irep2/irep2_utils.h>
 #include <util/message.h>
 #include <util/namespace.h>
@@ -135,11 +136,20 @@ public:
   /** Shorthand for a vector of smt_ast's */
   typedef std::vector<smt_astt> ast_vec;
 
+  /** Creates an AST in the arena of the current context. It is destroyed
+   *  when that context is popped, or by delete_all_asts. */
+  template <typename the_ast, typename... Args>
+  the_ast *make_ast(Args &&...args)
+  {
+    void *p = ast_arena.allocate(sizeof(the_ast), alignof(the_ast));
+    return new (p) the_ast(std::forward<Args>(args)...);
+  }
+
   template <typename the_solver_ast>
   smt_astt
   new_solver_ast(typename the_solver_ast::solver_ast_type ast, smt_sortt sort)
   {
-    return new the_solver_ast(this, ast, sort);
+    return make_ast<the_solver_ast>(this, ast, sort);
   }
 
   /** Primary constructor. After construction, smt_post_init must be called
@@ -232,6 +242,15 @@ public:
    *  @return Result code of the call to the solver. */
   virtual resultt dec_solve() = 0;
 
+  /** Ask a call to dec_solve running in another thread to give up as soon as
+   *  possible, in which case it returns P_ERROR. May be called from any
+   *  thread; has no effect on a dec_solve that has not started yet.
+   *  @return Whether this solver supports being interrupted. */
+  virtual bool interrupt()
+  {
+    return false;
+  }
+
   void pre_solve();
 
   /** Get the satisfying assignment using the type.
@@ -916,8 +935,11 @@ public:
   typedef std::map<std::string, smt_astt> renumber_mapt;
   std::vector<renumber_mapt> renumber_map;
 
+  /** Storage of smt ast's. When a context is pop'd, the memory of all the
+   *  ASTs created in that context is released in one go. */
+  smt_ast_arenat ast_arena;
   /** Lifetime tracking of smt ast's. When a context is pop'd, all the ASTs
-   *  created in that context are freed. */
+   *  created in that context are destroyed before the arena is rewound. */
   std::vector<smt_astt> live_asts;
   /** Accounting of live_asts for push/pop. Records the number of pointers
    *  contained when a push occurred. On pop, the live_asts vector is reset
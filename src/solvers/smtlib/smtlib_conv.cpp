@@ -8,12 +8,15 @@
 #include <solvers/smt/tuple/smt_tuple_node.h>
 
 #include <cinttypes>
-#include <regex>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 
 #ifndef _WIN32
 #  include <unistd.h>
+#  include <poll.h>
 #  include <signal.h>
+#  include <sys/wait.h>
 #endif
 
 // clang-format off
@@ -121,6 +124,10 @@ int smtlibparse(int startval);
 extern int smtlib_send_start_code;
 extern sexpr *smtlib_output;
 
+/// Set while reset() reads from a solver that may have died: a cut-off or
+/// malformed answer then only stops that process from being kept
+static bool smtlib_parse_errors_throw = false;
+
 #if 0
 static std::string unquote(const std::string_view &s)
 {
@@ -200,8 +207,73 @@ smtlib_convt::file_emitter::~file_emitter() noexcept
     fclose(out_stream);
 }
 
+#ifndef _WIN32
+namespace
+{
+/// A solver process no smtlib_convt is using
+struct idle_processt
+{
+  int pid;
+  FILE *out_stream;
+  FILE *in_stream;
+};
+
+void close_process(const idle_processt &proc)
+{
+  fclose(proc.out_stream);
+  fclose(proc.in_stream);
+  kill(proc.pid, SIGTERM);
+  waitpid(proc.pid, nullptr, 0);
+}
+
+/// The idle solver processes, by command line
+class process_poolt
+{
+public:
+  ~process_poolt()
+  {
+    for (const auto &[cmd, procs] : idle)
+      for (const idle_processt &proc : procs)
+        close_process(proc);
+  }
+
+  bool take(const std::string &cmd, idle_processt &proc)
+  {
+    std::lock_guard lock(mutex);
+    auto it = idle.find(cmd);
+    if (it == idle.end() || it->second.empty())
+      return false;
+    proc = it->second.back();
+    it->second.pop_back();
+    return true;
+  }
+
+  void give(const std::string &cmd, const idle_processt &proc)
+  {
+    std::lock_guard lock(mutex);
+    idle[cmd].push_back(proc);
+  }
+
+protected:
+  std::mutex mutex;
+  std::unordered_map<std::string, std::vector<idle_processt>> idle;
+};
+
+process_poolt &process_pool()
+{
+  static process_poolt pool;
+  return pool;
+}
+} // namespace
+#endif
+
 smtlib_convt::process_emitter::process_emitter(const std::string &cmd)
-  : out_stream(nullptr), in_stream(nullptr), org_sigpipe_handler(nullptr)
+  : out_stream(nullptr),
+    in_stream(nullptr),
+    org_sigpipe_handler(nullptr),
+    pid(0),
+    cmd(cmd),
+    broken(false)
 {
   if (cmd == "")
     return;
@@ -216,20 +288,25 @@ smtlib_convt::process_emitter::process_emitter(const std::string &cmd)
   log_error("smtlib works only in unix systems");
   abort();
 #else
-  if (pipe(inpipe) != 0)
+  idle_processt idle;
+  const bool reused = process_pool().take(cmd, idle);
+  if (reused)
+  {
+    pid = idle.pid;
+    out_stream = idle.out_stream;
+    in_stream = idle.in_stream;
+  }
+  else if (pipe(inpipe) != 0)
   {
     log_error("Couldn't open a pipe for smtlib solver");
     abort();
   }
-
-  if (pipe(outpipe) != 0)
+  else if (pipe(outpipe) != 0)
   {
     log_error("Couldn't open a pipe for smtlib solver");
     abort();
   }
-
-  pid_t solver_proc_pid = fork();
-  if (solver_proc_pid == 0)
+  else if ((pid = fork()) == 0)
   {
     close(outpipe[1]);
     close(inpipe[0]);
@@ -260,19 +337,29 @@ smtlib_convt::process_emitter::process_emitter(const std::string &cmd)
     out_stream = fdopen(outpipe[1], "w");
     in_stream = fdopen(inpipe[0], "r");
 
-    org_sigpipe_handler = reinterpret_cast<void *>(signal(SIGPIPE, SIG_IGN));
-    if (org_sigpipe_handler == SIG_ERR)
-    {
-      log_error("registering SIGPIPE handler: {}", strerror(errno));
-      abort();
-    }
+    // Formulae are written in many small pieces: send them in large chunks
+    setvbuf(out_stream, nullptr, _IOFBF, 1 << 20);
+  }
+
+  org_sigpipe_handler = reinterpret_cast<void *>(signal(SIGPIPE, SIG_IGN));
+  if (org_sigpipe_handler == SIG_ERR)
+  {
+    log_error("registering SIGPIPE handler: {}", strerror(errno));
+    abort();
   }
   // Execution continues as the parent ESBMC process. Child dying will
   // trigger SIGPIPE or an EOF eventually, which we'll be able to detect
   // and crash upon.
 
-  // Point lexer input at output stream
-  smtlib_tokin = in_stream;
+  // Point lexer input at output stream, dropping what it buffered from the
+  // previous process
+  smtlib_tokrestart(in_stream);
+
+  if (reused)
+  {
+    log_status("Re-using external solver cmd '{}' with PID {}", cmd, pid);
+    return;
+  }
 
   // Fetch solver name and version.
 #  if 0
@@ -332,21 +419,25 @@ smtlib_convt::process_emitter::process_emitter(const std::string &cmd)
     "Using external solver '{}' version '{}' with PID {}",
     solver_name,
     solver_version,
-    solver_proc_pid);
+    pid);
 #  else
-  log_status(
-    "Using external solver cmd '{}' with PID {}", cmd, solver_proc_pid);
+  log_status("Using external solver cmd '{}' with PID {}", cmd, pid);
 #  endif
 #endif
 }
 
 smtlib_convt::process_emitter::~process_emitter() noexcept
 {
-  if (out_stream)
-    fclose(out_stream);
-  if (in_stream)
-    fclose(in_stream);
 #ifndef _WIN32
+  if (out_stream)
+  {
+    idle_processt proc = {pid, out_stream, in_stream};
+    if (reset())
+      process_pool().give(cmd, proc);
+    else
+      close_process(proc);
+  }
+
   if (org_sigpipe_handler)
     signal(SIGPIPE, reinterpret_cast<void (*)(int)>(org_sigpipe_handler));
 #endif
@@ -386,6 +477,8 @@ std::string smtlib_convt::sort_to_string(const smt_sort *s) const
   case SMT_SORT_FIXEDBV:
   case SMT_SORT_BV:
   case SMT_SORT_BVFP:
+  // Named terms are declared with their sort, rounding modes included
+  case SMT_SORT_BVFP_RM:
     ss << "(_ BitVec " << sort->get_data_width() << ")";
     return ss.str();
   case SMT_SORT_ARRAY:
@@ -456,13 +549,21 @@ unsigned int smtlib_convt::emit_terminal_ast(
      *   \ -> /b
      *   | -> /p
      */
-    std::string replaced = ast->symname;
-    replaced = std::regex_replace(replaced, std::regex("/"), "//");
-    replaced = std::regex_replace(replaced, std::regex("\\\\"), "/b");
-    replaced = std::regex_replace(replaced, std::regex("\\|"), "/p");
-
-    ss << "|" << replaced << "|";
-    output = ss.str();
+    output.clear();
+    output.reserve(ast->symname.size() + 2);
+    output += '|';
+    for (char c : ast->symname)
+    {
+      if (c == '/')
+        output += "//";
+      else if (c == '\\')
+        output += "/b";
+      else if (c == '|')
+        output += "/p";
+      else
+        output += c;
+    }
+    output += '|';
     return 0;
   }
   default:
@@ -474,7 +575,8 @@ unsigned int smtlib_convt::emit_terminal_ast(
 unsigned int smtlib_convt::emit_ast(
   const smtlib_smt_ast *ast,
   std::string &output,
-  std::unordered_map<const smtlib_smt_ast *, std::string> &temp_symbols) const
+  std::unordered_map<const smtlib_smt_ast *, std::string> &temp_symbols,
+  bool use_definitions) const
 {
   unsigned int brace_level = 0;
   assert(ast->args.size() <= 4);
@@ -493,6 +595,13 @@ unsigned int smtlib_convt::emit_ast(
     // Continue.
   }
 
+  if (use_definitions)
+    if (auto it = defined_terms.find(ast); it != defined_terms.end())
+    {
+      output = it->name;
+      return 0;
+    }
+
   if (auto it = temp_symbols.find(ast); it != temp_symbols.end())
   {
     output = it->second;
@@ -509,7 +618,10 @@ unsigned int smtlib_convt::emit_ast(
 
   for (unsigned long int i = 0; i < ast->args.size(); i++)
     brace_level += emit_ast(
-      static_cast<const smtlib_smt_ast *>(ast->args[i]), args[i], temp_symbols);
+      static_cast<const smtlib_smt_ast *>(ast->args[i]),
+      args[i],
+      temp_symbols,
+      use_definitions);
 
   // Emit a let, assigning the result of this AST func to the sym.
   // For some reason let requires a double-braced operand.
@@ -539,7 +651,8 @@ unsigned int smtlib_convt::emit_ast(
   return brace_level + 1;
 }
 
-void smtlib_convt::emit_ast(const smtlib_smt_ast *ast) const
+void smtlib_convt::emit_ast(const smtlib_smt_ast *ast, bool use_definitions)
+  const
 {
   // The algorithm: descend through the AST operands, binding values to
   // temporary symbols, then emit functions on those temporary symbols.
@@ -549,7 +662,8 @@ void smtlib_convt::emit_ast(const smtlib_smt_ast *ast) const
 
   std::string output;
   std::unordered_map<const smtlib_smt_ast *, std::string> temp_symbols;
-  unsigned int brace_level = emit_ast(ast, output, temp_symbols);
+  unsigned int brace_level =
+    emit_ast(ast, output, temp_symbols, use_definitions);
 
   /* Emit the final representation of the root, either a (possibly temporary)
    * symbol, or that of a terminal. */
@@ -560,6 +674,55 @@ void smtlib_convt::emit_ast(const smtlib_smt_ast *ast) const
     emit("%c", ')');
 }
 
+void smtlib_convt::define_ast(const smtlib_smt_ast *ast, std::string &output)
+{
+  switch (ast->kind)
+  {
+  case SMT_FUNC_INT:
+  case SMT_FUNC_BOOL:
+  case SMT_FUNC_BVINT:
+  case SMT_FUNC_REAL:
+  case SMT_FUNC_SYMBOL:
+    emit_terminal_ast(ast, output);
+    return;
+  default:
+    break;
+  }
+
+  if (auto it = defined_terms.find(ast); it != defined_terms.end())
+  {
+    output = it->name;
+    return;
+  }
+
+  assert(ast->args.size() <= 4);
+  std::string args[4];
+  for (unsigned long int i = 0; i < ast->args.size(); i++)
+    define_ast(static_cast<const smtlib_smt_ast *>(ast->args[i]), args[i]);
+
+  std::string name = "?t" + std::to_string(num_defined_terms++);
+
+  // Build the whole definition first, it is written in one go
+  std::string def = "(define-fun " + name + " () " +
+                    sort_to_string(ast->sort) + " (";
+  assert(static_cast<size_t>(ast->kind) < smt_func_name_table.size());
+  if (ast->kind == SMT_FUNC_EXTRACT)
+    def += "(_ extract " + std::to_string(ast->extract_high) + " " +
+           std::to_string(ast->extract_low) + ")";
+  else
+    def += smt_func_name_table[ast->kind];
+  for (unsigned long int i = 0; i < ast->args.size(); i++)
+  {
+    def += ' ';
+    def += args[i];
+  }
+  def += "))\n";
+  emit("%s", def.c_str());
+
+  defined_terms.insert({ast, name, ctx_level});
+  output = std::move(name);
+}
+
 void smtlib_smt_ast::dump() const
 {
   const smtlib_convt *ctx = static_cast<const smtlib_convt *>(context);
@@ -570,7 +733,7 @@ void smtlib_smt_ast::dump() const
   FILE *tmp_file = std::exchange(ctx_m->emit_opt_output.out_stream, stderr);
   FILE *tmp_proc = std::exchange(ctx_m->emit_proc.out_stream, nullptr);
 
-  ctx->emit_ast(this);
+  ctx->emit_ast(this, false);
   ctx->emit("%s", "\n");
   std::string sort_str = ctx->sort_to_string(sort);
   ctx->emit("sort: %s\n", sort_str.c_str());
@@ -743,7 +906,10 @@ void smtlib_convt::process_emitter::emit(const char *fmt, Ts &&...ts) const
   /* TODO: other error handling */
   errno = 0;
   if (fprintf(out_stream, fmt, ts...) < 0 && errno == EPIPE)
+  {
+    broken = true;
     throw external_process_died(read_all(in_stream));
+  }
 }
 
 void smtlib_convt::process_emitter::flush() const
@@ -751,7 +917,64 @@ void smtlib_convt::process_emitter::flush() const
   /* TODO: other error handling */
   errno = 0;
   if (fflush(out_stream) == EOF && errno == EPIPE)
+  {
+    broken = true;
     throw external_process_died(read_all(in_stream));
+  }
+}
+
+bool smtlib_convt::process_emitter::reset() const
+{
+  if (broken)
+    return false;
+
+#ifndef _WIN32
+  // Do not write to a process that already exited; WNOWAIT leaves it to be
+  // reaped by close_process()
+  siginfo_t status{};
+  if (
+    waitid(P_PID, pid, &status, WEXITED | WNOHANG | WNOWAIT) != 0 ||
+    status.si_pid != 0)
+    return false;
+#endif
+
+  try
+  {
+    emit("%s", "(reset)\n(check-sat)\n");
+    flush();
+  }
+  catch (const external_process_died &)
+  {
+    return false;
+  }
+
+#ifndef _WIN32
+  // Do not hang on a solver that stopped answering, or that closed its output
+  pollfd answer = {fileno(in_stream), POLLIN, 0};
+  if (
+    poll(&answer, 1, reset_timeout_ms) != 1 || !(answer.revents & POLLIN) ||
+    (answer.revents & POLLHUP))
+    return false;
+#endif
+
+  // Output nobody read, e.g. an error about a command sent after the last
+  // check-sat, comes before the answer to this check-sat
+  bool answered = false;
+  smtlib_parse_errors_throw = true;
+  try
+  {
+    smtlib_tokin = in_stream;
+    smtlib_send_start_code = 1;
+    smtlibparse(TOK_START_SAT);
+    answered = smtlib_output->token == TOK_KW_SAT;
+    delete smtlib_output;
+  }
+  catch (const external_process_died &e)
+  {
+    log_debug("smtlib", "Not keeping solver process {}: {}", pid, e.what());
+  }
+  smtlib_parse_errors_throw = false;
+  return answered;
 }
 
 smtlib_convt::file_emitter::operator bool() const noexcept
@@ -825,19 +1048,16 @@ void smtlib_convt::assert_ast(smt_astt a)
 {
   const smtlib_smt_ast *sa = static_cast<const smtlib_smt_ast *>(a);
 
-  // Encode an assertion
-  emit("%s", "(assert\n");
-
-  emit_ast(sa);
-
-  // Final brace for closing the 'assert'.
-  emit("%s", ")\n");
+  // Encode an assertion on the named term
+  std::string output;
+  define_ast(sa, output);
+  emit("(assert %s)\n", output.c_str());
 }
 
 smt_astt smtlib_convt::mk_smt_int(const BigInt &theint)
 {
   smt_sortt s = mk_int_sort();
-  smtlib_smt_ast *a = new smtlib_smt_ast(this, s, SMT_FUNC_INT);
+  smtlib_smt_ast *a = make_ast<smtlib_smt_ast>(this, s, SMT_FUNC_INT);
   a->intval = theint;
   return a;
 }
@@ -845,21 +1065,22 @@ smt_astt smtlib_convt::mk_smt_int(const BigInt &theint)
 smt_astt smtlib_convt::mk_smt_real(const std::string &str)
 {
   smt_sortt s = mk_real_sort();
-  smtlib_smt_ast *a = new smtlib_smt_ast(this, s, SMT_FUNC_REAL);
+  smtlib_smt_ast *a = make_ast<smtlib_smt_ast>(this, s, SMT_FUNC_REAL);
   a->realval = str;
   return a;
 }
 
 smt_astt smtlib_convt::mk_smt_bv(const BigInt &theint, smt_sortt s)
 {
-  smtlib_smt_ast *a = new smtlib_smt_ast(this, s, SMT_FUNC_BVINT);
+  smtlib_smt_ast *a = make_ast<smtlib_smt_ast>(this, s, SMT_FUNC_BVINT);
   a->intval = theint;
   return a;
 }
 
 smt_astt smtlib_convt::mk_smt_bool(bool val)
 {
-  smtlib_smt_ast *a = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_BOOL);
+  smtlib_smt_ast *a =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_BOOL);
   a->boolval = val;
   return a;
 }
@@ -874,7 +1095,7 @@ smt_astt smtlib_convt::mk_array_symbol(
 
 smt_astt smtlib_convt::mk_smt_symbol(const std::string &name, const smt_sort *s)
 {
-  smtlib_smt_ast *a = new smtlib_smt_ast(this, s, SMT_FUNC_SYMBOL);
+  smtlib_smt_ast *a = make_ast<smtlib_smt_ast>(this, s, SMT_FUNC_SYMBOL);
   a->symname = name;
 
   symbol_tablet::iterator it = symbol_table.find(name);
@@ -907,7 +1128,7 @@ smt_astt
 smtlib_convt::mk_extract(smt_astt a, unsigned int high, unsigned int low)
 {
   smt_sortt s = mk_bv_sort(high - low + 1);
-  smtlib_smt_ast *n = new smtlib_smt_ast(this, s, SMT_FUNC_EXTRACT);
+  smtlib_smt_ast *n = make_ast<smtlib_smt_ast>(this, s, SMT_FUNC_EXTRACT);
   n->extract_high = high;
   n->extract_low = low;
   n->args.push_back(a);
@@ -949,7 +1170,7 @@ smt_astt smtlib_convt::mk_concat(smt_astt a, smt_astt b)
       - concatenation of bitvectors of size i and j to get a new bitvector of
         size m, where m = i + j
   */
-  smtlib_smt_ast *ast = new smtlib_smt_ast(
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(
     this,
     mk_bv_sort(a->sort->get_data_width() + b->sort->get_data_width()),
     SMT_FUNC_CONCAT);
@@ -963,7 +1184,7 @@ smt_astt smtlib_convt::mk_ite(smt_astt cond, smt_astt t, smt_astt f)
   assert(cond->sort->id == SMT_SORT_BOOL);
   assert(t->sort->get_data_width() == f->sort->get_data_width());
 
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, t->sort, SMT_FUNC_ITE);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, t->sort, SMT_FUNC_ITE);
   ast->args.push_back(cond);
   ast->args.push_back(t);
   ast->args.push_back(f);
@@ -972,6 +1193,9 @@ smt_astt smtlib_convt::mk_ite(smt_astt cond, smt_astt t, smt_astt f)
 
 int smtliberror(int startsym [[maybe_unused]], const std::string &error)
 {
+  if (smtlib_parse_errors_throw)
+    throw smtlib_convt::external_process_died(error);
+
   log_error("SMTLIB response parsing: \"{}\"", error);
   abort();
 }
@@ -988,7 +1212,7 @@ smt_astt smtlib_convt::mk_add(smt_astt a, smt_astt b)
   assert(a->sort->id == SMT_SORT_INT || a->sort->id == SMT_SORT_REAL);
   assert(b->sort->id == SMT_SORT_INT || b->sort->id == SMT_SORT_REAL);
   assert(a->sort->id == b->sort->id);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_ADD);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_ADD);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -999,7 +1223,7 @@ smt_astt smtlib_convt::mk_bvadd(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVADD);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVADD);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1010,7 +1234,7 @@ smt_astt smtlib_convt::mk_sub(smt_astt a, smt_astt b)
   assert(a->sort->id == SMT_SORT_INT || a->sort->id == SMT_SORT_REAL);
   assert(b->sort->id == SMT_SORT_INT || b->sort->id == SMT_SORT_REAL);
   assert(a->sort->id == b->sort->id);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_SUB);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_SUB);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1021,7 +1245,7 @@ smt_astt smtlib_convt::mk_bvsub(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVSUB);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVSUB);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1032,7 +1256,7 @@ smt_astt smtlib_convt::mk_mul(smt_astt a, smt_astt b)
   assert(a->sort->id == SMT_SORT_INT || a->sort->id == SMT_SORT_REAL);
   assert(b->sort->id == SMT_SORT_INT || b->sort->id == SMT_SORT_REAL);
   assert(a->sort->id == b->sort->id);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_MUL);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_MUL);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1043,7 +1267,7 @@ smt_astt smtlib_convt::mk_bvmul(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVMUL);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVMUL);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1054,7 +1278,7 @@ smt_astt smtlib_convt::mk_mod(smt_astt a, smt_astt b)
   assert(a->sort->id == SMT_SORT_INT || a->sort->id == SMT_SORT_REAL);
   assert(b->sort->id == SMT_SORT_INT || b->sort->id == SMT_SORT_REAL);
   assert(a->sort->id == b->sort->id);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_MOD);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_MOD);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1065,7 +1289,8 @@ smt_astt smtlib_convt::mk_bvsmod(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVSMOD);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVSMOD);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1076,7 +1301,8 @@ smt_astt smtlib_convt::mk_bvumod(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVUMOD);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVUMOD);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1087,7 +1313,7 @@ smt_astt smtlib_convt::mk_div(smt_astt a, smt_astt b)
   assert(a->sort->id == SMT_SORT_INT || a->sort->id == SMT_SORT_REAL);
   assert(b->sort->id == SMT_SORT_INT || b->sort->id == SMT_SORT_REAL);
   assert(a->sort->id == b->sort->id);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_DIV);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_DIV);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1098,7 +1324,8 @@ smt_astt smtlib_convt::mk_bvsdiv(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVSDIV);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVSDIV);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1109,7 +1336,8 @@ smt_astt smtlib_convt::mk_bvudiv(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVUDIV);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVUDIV);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1120,7 +1348,7 @@ smt_astt smtlib_convt::mk_shl(smt_astt a, smt_astt b)
   assert(a->sort->id == SMT_SORT_INT || a->sort->id == SMT_SORT_REAL);
   assert(b->sort->id == SMT_SORT_INT || b->sort->id == SMT_SORT_REAL);
   assert(a->sort->id == b->sort->id);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_SHL);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_SHL);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1131,7 +1359,7 @@ smt_astt smtlib_convt::mk_bvshl(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVSHL);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVSHL);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1142,7 +1370,8 @@ smt_astt smtlib_convt::mk_bvashr(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVASHR);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVASHR);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1153,7 +1382,8 @@ smt_astt smtlib_convt::mk_bvlshr(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVLSHR);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVLSHR);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1162,7 +1392,7 @@ smt_astt smtlib_convt::mk_bvlshr(smt_astt a, smt_astt b)
 smt_astt smtlib_convt::mk_neg(smt_astt a)
 {
   assert(a->sort->id == SMT_SORT_INT || a->sort->id == SMT_SORT_REAL);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_NEG);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_NEG);
   ast->args.push_back(a);
   return ast;
 }
@@ -1170,7 +1400,7 @@ smt_astt smtlib_convt::mk_neg(smt_astt a)
 smt_astt smtlib_convt::mk_bvneg(smt_astt a)
 {
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVNEG);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVNEG);
   ast->args.push_back(a);
   return ast;
 }
@@ -1178,7 +1408,7 @@ smt_astt smtlib_convt::mk_bvneg(smt_astt a)
 smt_astt smtlib_convt::mk_bvnot(smt_astt a)
 {
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVNOT);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVNOT);
   ast->args.push_back(a);
   return ast;
 }
@@ -1188,7 +1418,8 @@ smt_astt smtlib_convt::mk_bvnxor(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVNXOR);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVNXOR);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1199,7 +1430,7 @@ smt_astt smtlib_convt::mk_bvnor(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVNOR);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVNOR);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1210,7 +1441,8 @@ smt_astt smtlib_convt::mk_bvnand(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVNAND);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVNAND);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1221,7 +1453,7 @@ smt_astt smtlib_convt::mk_bvxor(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVXOR);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVXOR);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1232,7 +1464,7 @@ smt_astt smtlib_convt::mk_bvor(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVOR);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVOR);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1243,7 +1475,7 @@ smt_astt smtlib_convt::mk_bvand(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_BVAND);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_BVAND);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1253,7 +1485,7 @@ smt_astt smtlib_convt::mk_implies(smt_astt a, smt_astt b)
 {
   assert(a->sort->id == SMT_SORT_BOOL && b->sort->id == SMT_SORT_BOOL);
   smtlib_smt_ast *ast =
-    new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_IMPLIES);
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_IMPLIES);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1262,7 +1494,8 @@ smt_astt smtlib_convt::mk_implies(smt_astt a, smt_astt b)
 smt_astt smtlib_convt::mk_xor(smt_astt a, smt_astt b)
 {
   assert(a->sort->id == SMT_SORT_BOOL && b->sort->id == SMT_SORT_BOOL);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_XOR);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_XOR);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1271,7 +1504,8 @@ smt_astt smtlib_convt::mk_xor(smt_astt a, smt_astt b)
 smt_astt smtlib_convt::mk_or(smt_astt a, smt_astt b)
 {
   assert(a->sort->id == SMT_SORT_BOOL && b->sort->id == SMT_SORT_BOOL);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_OR);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_OR);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1280,7 +1514,8 @@ smt_astt smtlib_convt::mk_or(smt_astt a, smt_astt b)
 smt_astt smtlib_convt::mk_and(smt_astt a, smt_astt b)
 {
   assert(a->sort->id == SMT_SORT_BOOL && b->sort->id == SMT_SORT_BOOL);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_AND);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_AND);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1289,7 +1524,8 @@ smt_astt smtlib_convt::mk_and(smt_astt a, smt_astt b)
 smt_astt smtlib_convt::mk_not(smt_astt a)
 {
   assert(a->sort->id == SMT_SORT_BOOL);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_NOT);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_NOT);
   ast->args.push_back(a);
   return ast;
 }
@@ -1298,7 +1534,8 @@ smt_astt smtlib_convt::mk_lt(smt_astt a, smt_astt b)
 {
   assert(a->sort->id == SMT_SORT_INT || a->sort->id == SMT_SORT_REAL);
   assert(b->sort->id == SMT_SORT_INT || b->sort->id == SMT_SORT_REAL);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_LT);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_LT);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1309,7 +1546,8 @@ smt_astt smtlib_convt::mk_bvult(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_BVULT);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_BVULT);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1320,7 +1558,8 @@ smt_astt smtlib_convt::mk_bvslt(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_BVSLT);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_BVSLT);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1330,7 +1569,8 @@ smt_astt smtlib_convt::mk_gt(smt_astt a, smt_astt b)
 {
   assert(a->sort->id == SMT_SORT_INT || a->sort->id == SMT_SORT_REAL);
   assert(b->sort->id == SMT_SORT_INT || b->sort->id == SMT_SORT_REAL);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_GT);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_GT);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1341,7 +1581,8 @@ smt_astt smtlib_convt::mk_bvugt(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_BVUGT);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_BVUGT);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1352,7 +1593,8 @@ smt_astt smtlib_convt::mk_bvsgt(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_BVSGT);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_BVSGT);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1362,7 +1604,8 @@ smt_astt smtlib_convt::mk_le(smt_astt a, smt_astt b)
 {
   assert(a->sort->id == SMT_SORT_INT || a->sort->id == SMT_SORT_REAL);
   assert(b->sort->id == SMT_SORT_INT || b->sort->id == SMT_SORT_REAL);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_LTE);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_LTE);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1373,7 +1616,8 @@ smt_astt smtlib_convt::mk_bvule(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_BVULTE);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_BVULTE);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1384,7 +1628,8 @@ smt_astt smtlib_convt::mk_bvsle(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_BVSLTE);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_BVSLTE);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1394,7 +1639,8 @@ smt_astt smtlib_convt::mk_ge(smt_astt a, smt_astt b)
 {
   assert(a->sort->id == SMT_SORT_INT || a->sort->id == SMT_SORT_REAL);
   assert(b->sort->id == SMT_SORT_INT || b->sort->id == SMT_SORT_REAL);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_GTE);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_GTE);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1405,7 +1651,8 @@ smt_astt smtlib_convt::mk_bvuge(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_BVUGTE);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_BVUGTE);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1416,7 +1663,8 @@ smt_astt smtlib_convt::mk_bvsge(smt_astt a, smt_astt b)
   assert(a->sort->id != SMT_SORT_INT && a->sort->id != SMT_SORT_REAL);
   assert(b->sort->id != SMT_SORT_INT && b->sort->id != SMT_SORT_REAL);
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_BVSGTE);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_BVSGTE);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1425,7 +1673,8 @@ smt_astt smtlib_convt::mk_bvsge(smt_astt a, smt_astt b)
 smt_astt smtlib_convt::mk_eq(smt_astt a, smt_astt b)
 {
   assert(a->sort->get_data_width() == b->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_EQ);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_EQ);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1437,7 +1686,7 @@ smt_astt smtlib_convt::mk_store(smt_astt a, smt_astt b, smt_astt c)
   assert(a->sort->get_domain_width() == b->sort->get_data_width());
   assert(
     a->sort->get_range_sort()->get_data_width() == c->sort->get_data_width());
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_STORE);
+  smtlib_smt_ast *ast = make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_STORE);
   ast->args.push_back(a);
   ast->args.push_back(b);
   ast->args.push_back(c);
@@ -1449,7 +1698,7 @@ smt_astt smtlib_convt::mk_select(smt_astt a, smt_astt b)
   assert(a->sort->id == SMT_SORT_ARRAY);
   assert(a->sort->get_domain_width() == b->sort->get_data_width());
   smtlib_smt_ast *ast =
-    new smtlib_smt_ast(this, a->sort->get_range_sort(), SMT_FUNC_SELECT);
+    make_ast<smtlib_smt_ast>(this, a->sort->get_range_sort(), SMT_FUNC_SELECT);
   ast->args.push_back(a);
   ast->args.push_back(b);
   return ast;
@@ -1458,7 +1707,8 @@ smt_astt smtlib_convt::mk_select(smt_astt a, smt_astt b)
 smt_astt smtlib_convt::mk_real2int(smt_astt a)
 {
   assert(a->sort->id == SMT_SORT_REAL);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_REAL2INT);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_REAL2INT);
   ast->args.push_back(a);
   return ast;
 }
@@ -1466,7 +1716,8 @@ smt_astt smtlib_convt::mk_real2int(smt_astt a)
 smt_astt smtlib_convt::mk_int2real(smt_astt a)
 {
   assert(a->sort->id == SMT_SORT_INT);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, a->sort, SMT_FUNC_INT2REAL);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, a->sort, SMT_FUNC_INT2REAL);
   ast->args.push_back(a);
   return ast;
 }
@@ -1474,7 +1725,8 @@ smt_astt smtlib_convt::mk_int2real(smt_astt a)
 smt_astt smtlib_convt::mk_isint(smt_astt a)
 {
   assert(a->sort->id == SMT_SORT_INT || a->sort->id == SMT_SORT_REAL);
-  smtlib_smt_ast *ast = new smtlib_smt_ast(this, boolean_sort, SMT_FUNC_IS_INT);
+  smtlib_smt_ast *ast =
+    make_ast<smtlib_smt_ast>(this, boolean_sort, SMT_FUNC_IS_INT);
   ast->args.push_back(a);
   return ast;
 }
@@ -1486,6 +1738,7 @@ void smtlib_convt::pop_ctx()
   // Wipe this level of symbol table.
   symbol_tablet::nth_index<1>::type &syms_numindex = symbol_table.get<1>();
   syms_numindex.erase(ctx_level);
+  defined_terms.get<1>().erase(ctx_level);
 
   smt_convt::pop_ctx();
 }
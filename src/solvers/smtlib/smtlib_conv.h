@@ -279,10 +279,20 @@ public:
   unsigned int emit_ast(
     const smtlib_smt_ast *ast,
     std::string &output,
-    std::unordered_map<const smtlib_smt_ast *, std::string> &temp_symbols)
-    const;
+    std::unordered_map<const smtlib_smt_ast *, std::string> &temp_symbols,
+    bool use_definitions) const;
 
-  void emit_ast(const smtlib_smt_ast *ast) const;
+  /** Emits `ast` as a single term, binding its non-terminal operands with
+   *  let. With `use_definitions`, the terms already named by define_ast()
+   *  are referred to by their name. Unlike define_ast(), this leaves the
+   *  assertion stack untouched, so can follow a check-sat. */
+  void emit_ast(const smtlib_smt_ast *ast, bool use_definitions = true) const;
+
+  /** Names `ast` and each of its non-terminal operands with a define-fun
+   *  unless they already have a name, and sets `output` to the term that
+   *  stands for `ast`. Terms shared by several assertions are thus sent to
+   *  the solver once. */
+  void define_ast(const smtlib_smt_ast *ast, std::string &output);
 
   void push_ctx() override;
   void pop_ctx() override;
@@ -295,11 +305,22 @@ public:
 
   // Members
 
+  /**
+   * Pipes to the external solver process. The process outlives this object:
+   * when it is destroyed, a process that still answers is reset and kept
+   * idle, and the next process_emitter started with the same command takes
+   * it over instead of starting a new one. This saves a process start per
+   * claim or k-step.
+   */
   struct process_emitter
   {
     FILE *out_stream;
     FILE *in_stream;
     void *org_sigpipe_handler; /* TODO: static */
+    int pid;
+    std::string cmd;
+    /// Set once the process stopped answering; it is not kept then
+    mutable bool broken;
 
     std::string solver_name;
     std::string solver_version;
@@ -315,6 +336,12 @@ public:
     void emit(const char *fmt, Ts &&...) const;
     void flush() const;
 
+    /** Resets the solver and checks that it answers the next command.
+     *  @return Whether the process can be handed to another smtlib_convt */
+    bool reset() const;
+    /// How long reset() waits for the solver to answer
+    static constexpr int reset_timeout_ms = 5000;
+
     explicit operator bool() const noexcept;
   } emit_proc;
 
@@ -358,6 +385,30 @@ public:
 
   symbol_tablet symbol_table;
 
+  // The terms named by define_ast(), and the level they were named at.
+
+  struct defined_term_rec
+  {
+    const smtlib_smt_ast *ast;
+    std::string name;
+    unsigned int level;
+  };
+
+  typedef boost::multi_index_container<
+    defined_term_rec,
+    boost::multi_index::indexed_by<
+      boost::multi_index::hashed_unique<BOOST_MULTI_INDEX_MEMBER(
+        defined_term_rec,
+        const smtlib_smt_ast *,
+        ast)>,
+      boost::multi_index::ordered_non_unique<
+        BOOST_MULTI_INDEX_MEMBER(defined_term_rec, unsigned int, level),
+        std::greater<unsigned int>>>>
+    defined_termst;
+
+  defined_termst defined_terms;
+  size_t num_defined_terms = 0;
+
   static const std::string temp_prefix;
 
   struct external_process_died : std::runtime_error
@@ -98,6 +98,13 @@ smt_convt::resultt yices_convt::dec_solve()
   return smt_convt::P_ERROR;
 }
 
+bool yices_convt::interrupt()
+{
+  // Only has an effect while yices_check_context is searching
+  yices_stop_search(yices_ctx);
+  return true;
+}
+
 const std::string yices_convt::solver_text()
 {
   std::stringstream ss;
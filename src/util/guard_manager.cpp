@@ -0,0 +1,153 @@
+#include <util/guard_manager.h>
+#include <irep2/irep2_utils.h>
+
+guard_managert::guard_managert() : nodes(1)
+{
+}
+
+guard_managert::edget guard_managert::atom(const expr2tc &expr)
+{
+  auto [it, inserted] = atom_table.emplace(expr, nodes.size());
+  if (inserted)
+  {
+    nodes.emplace_back();
+    nodes.back().atom = expr;
+  }
+  return it->second << 1;
+}
+
+guard_managert::edget guard_managert::make_and(edget a, edget b)
+{
+  uint64_t key = (uint64_t(a) << 32) | b;
+  auto [it, inserted] = and_table.emplace(key, nodes.size());
+  if (inserted)
+  {
+    nodes.emplace_back();
+    nodes.back().left = a;
+    nodes.back().right = b;
+  }
+  return it->second << 1;
+}
+
+guard_managert::edget guard_managert::conjunction(edget a, edget b)
+{
+  if (a > b)
+    std::swap(a, b);
+
+  if (a == false_edge || a == negation(b))
+    return false_edge;
+  if (a == true_edge || a == b)
+    return b;
+
+  // Look at the operands of either side
+  for (unsigned i = 0; i < 2; i++, std::swap(a, b))
+  {
+    if (!is_and(a))
+      continue;
+
+    edget x = nodes[node_of(a)].left;
+    edget y = nodes[node_of(a)].right;
+    if (!is_negated(a))
+    {
+      // (x && y) && !x is false; (x && y) && x is (x && y)
+      if (b == negation(x) || b == negation(y))
+        return false_edge;
+      if (b == x || b == y)
+        return a;
+      continue;
+    }
+
+    // !(x && y) && !x is !x; !(x && y) && x is !y && x
+    if (b == negation(x) || b == negation(y))
+      return b;
+    if (b == x)
+      return conjunction(negation(y), b);
+    if (b == y)
+      return conjunction(negation(x), b);
+
+    // !(x && y) && !(x && z) is !(x && (y || z)), which is how the guards of
+    // two paths that split after a common prefix are joined
+    if (!is_and(b) || !is_negated(b))
+      continue;
+
+    edget v = nodes[node_of(b)].left;
+    edget w = nodes[node_of(b)].right;
+    if (x == v)
+      return negation(conjunction(x, disjunction(y, w)));
+    if (x == w)
+      return negation(conjunction(x, disjunction(y, v)));
+    if (y == v)
+      return negation(conjunction(y, disjunction(x, w)));
+    if (y == w)
+      return negation(conjunction(y, disjunction(x, v)));
+  }
+
+  return make_and(a, b);
+}
+
+guard_managert::edget guard_managert::from_expr(const expr2tc &expr)
+{
+  std::unordered_map<const expr2t *, edget> cache;
+  return from_expr(expr, cache);
+}
+
+guard_managert::edget guard_managert::from_expr(
+  const expr2tc &expr,
+  std::unordered_map<const expr2t *, edget> &cache)
+{
+  if (is_true(expr))
+    return true_edge;
+  if (is_false(expr))
+    return false_edge;
+  if (is_not2t(expr))
+    return negation(from_expr(to_not2t(expr).value, cache));
+  if (!is_and2t(expr) && !is_or2t(expr))
+    return atom(expr);
+
+  // Guards share most of their structure; only take it apart once
+  auto it = cache.find(expr.get());
+  if (it != cache.end())
+    return it->second;
+
+  edget e;
+  if (is_and2t(expr))
+  {
+    const and2t &a = to_and2t(expr);
+    e = conjunction(from_expr(a.side_1, cache), from_expr(a.side_2, cache));
+  }
+  else
+  {
+    const or2t &o = to_or2t(expr);
+    e = disjunction(from_expr(o.side_1, cache), from_expr(o.side_2, cache));
+  }
+
+  cache.emplace(expr.get(), e);
+  return e;
+}
+
+expr2tc guard_managert::as_expr(edget e)
+{
+  if (e == false_edge)
+    return gen_false_expr();
+  if (e == true_edge)
+    return gen_true_expr();
+
+  unsigned n = node_of(e);
+  if (!is_nil_expr(nodes[n].exprs[is_negated(e)]))
+    return nodes[n].exprs[is_negated(e)];
+
+  expr2tc res;
+  if (!is_and(e))
+    res = is_negated(e) ? not2tc(nodes[n].atom) : nodes[n].atom;
+  else if (!is_negated(e))
+    res = and2tc(as_expr(nodes[n].left), as_expr(nodes[n].right));
+  else
+  {
+    // Print !(!x && !y) as x || y
+    res = or2tc(
+      as_expr(negation(nodes[n].left)), as_expr(negation(nodes[n].right)));
+  }
+
+  nodes[n].exprs[is_negated(e)] = res;
+  return res;
+}
@@ -0,0 +1,98 @@
+#ifndef CPROVER_UTIL_GUARD_MANAGER_H
+#define CPROVER_UTIL_GUARD_MANAGER_H
+
+#include <cstdint>
+#include <irep2/irep2.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Hash-consed and-inverter graph of path conditions, for
+ * --compact-guards.
+ *
+ * A guard is an edge into a graph of two-input and nodes over atoms, the
+ * branch conditions of the program. An edge is a node number and a bit telling
+ * whether it is negated, so that negation is free, and a conjunction or
+ * disjunction creates at most one node, after looking it up in the table of
+ * the nodes created so far. Structurally equal guards thus always become the
+ * same edge, and as_expr() turns them into the very same expression.
+ *
+ * Conjunctions are simplified by looking one level into their operands, e.g.
+ * (a && b) && !a becomes false and (a && b) || (a && !b) becomes a.
+ */
+class guard_managert
+{
+public:
+  /// Node number times two, plus one if negated
+  typedef unsigned edget;
+  static constexpr edget false_edge = 0;
+  static constexpr edget true_edge = 1;
+
+  guard_managert();
+
+  /// @return the edge for `expr`, taking apart the and, or and not
+  /// expressions in it and treating any other expression as an atom
+  edget from_expr(const expr2tc &expr);
+
+  static edget negation(edget e)
+  {
+    return e ^ 1;
+  }
+
+  edget conjunction(edget a, edget b);
+
+  edget disjunction(edget a, edget b)
+  {
+    return negation(conjunction(negation(a), negation(b)));
+  }
+
+  /// @return the expression for `e`; the same edge always gives the same one
+  expr2tc as_expr(edget e);
+
+  /// @return number of nodes, atoms included
+  size_t size() const
+  {
+    return nodes.size();
+  }
+
+protected:
+  struct nodet
+  {
+    /// Operands of an and node
+    edget left, right;
+    /// Or the expression of an atom
+    expr2tc atom;
+    /// as_expr() of the node and of its negation, once built
+    expr2tc exprs[2];
+  };
+
+  static unsigned node_of(edget e)
+  {
+    return e >> 1;
+  }
+
+  static bool is_negated(edget e)
+  {
+    return e & 1;
+  }
+
+  bool is_and(edget e) const
+  {
+    return node_of(e) != 0 && is_nil_expr(nodes[node_of(e)].atom);
+  }
+
+  edget atom(const expr2tc &expr);
+  edget make_and(edget a, edget b);
+  edget from_expr(
+    const expr2tc &expr,
+    std::unordered_map<const expr2t *, edget> &cache);
+
+  /// Node 0 is the constant false
+  std::vector<nodet> nodes;
+  /// And nodes, by their operands
+  std::unordered_map<uint64_t, unsigned> and_table;
+  /// Atom nodes, by their expression
+  std::unordered_map<expr2tc, unsigned, irep2_hash> atom_table;
+};
+
+#endif
@@ -11,6 +11,7 @@
 #define SHARING
 
 #include <util/dstring.h>
+#include <util/sorted_list_map.h>
 
 typedef dstring irep_idt;
 typedef dstring irep_namet;
@@ -40,7 +41,9 @@ public:
   typedef std::vector<irept> subt;
   //typedef std::list<irept> subt;
 
-  typedef std::map<irep_namet, irept> named_subt;
+  /** Named operands are few per node: a sorted list is smaller and as fast
+   *  to search as a tree */
+  typedef sorted_list_mapt<irep_namet, irept> named_subt;
 
   // Dump contents of irep to stdout. Debugging only.
   void dump() const;
@@ -0,0 +1,409 @@
+#ifndef CPROVER_PERSISTENT_MAP_H
+#define CPROVER_PERSISTENT_MAP_H
+
+#include <bitset>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * Hash map with structural sharing: a hash array mapped trie.
+ *
+ * Copying a map is O(1), it only shares the root of the trie. Mutations copy
+ * the (at most 64 / 5) nodes on the path from the root to the modified entry
+ * when they are shared with another map, and modify them in place otherwise.
+ * Two maps descending from the same original hence share all subtrees that
+ * neither of them touched, which for_each_unshared() uses to visit only the
+ * entries that may differ.
+ *
+ * Every interior node splits on five more bits of the hash, lowest bits first,
+ * and keeps its children densely packed behind a 32 bit occupancy bitmap.
+ * Leaves hold all entries whose keys have the same full hash.
+ *
+ * Values are only reachable through const references, except for the pointers
+ * returned by insert() and find_mutable(), which unshare the entry first.
+ */
+template <
+  class Key,
+  class T,
+  class Hash = std::hash<Key>,
+  class KeyEqual = std::equal_to<Key>>
+class persistent_mapt
+{
+public:
+  typedef Key key_type;
+  typedef T mapped_type;
+  typedef std::pair<Key, T> value_type;
+
+protected:
+  static constexpr unsigned bits = 5;
+  static constexpr size_t mask = (1 << bits) - 1;
+
+  struct nodet
+  {
+    /** Interior nodes: which of the 32 children are present */
+    uint32_t bitmap = 0;
+    std::vector<std::shared_ptr<nodet>> children;
+    /** Leaves: the hash of all of their entries */
+    size_t hash = 0;
+    std::vector<value_type> entries;
+
+    bool is_leaf() const
+    {
+      return !entries.empty();
+    }
+
+    /** @return the position of the child for `slot` within `children` */
+    size_t position(size_t slot) const
+    {
+      return std::bitset<32>(bitmap & ((uint32_t(1) << slot) - 1)).count();
+    }
+
+    bool has_child(size_t slot) const
+    {
+      return bitmap & (uint32_t(1) << slot);
+    }
+  };
+
+public:
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename persistent_mapt::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type *pointer;
+    typedef const value_type &reference;
+
+    const_iterator() = default;
+
+    reference operator*() const
+    {
+      return stack.back().first->entries[stack.back().second];
+    }
+
+    pointer operator->() const
+    {
+      return &**this;
+    }
+
+    const_iterator &operator++()
+    {
+      ++stack.back().second;
+      settle();
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const
+    {
+      return stack == other.stack;
+    }
+
+    bool operator!=(const const_iterator &other) const
+    {
+      return !(*this == other);
+    }
+
+  protected:
+    friend class persistent_mapt;
+
+    explicit const_iterator(const nodet *root)
+    {
+      if (root)
+      {
+        stack.emplace_back(root, 0);
+        settle();
+      }
+    }
+
+    /** Moves to the next entry in depth-first order, unless the top of the
+     *  stack already is one */
+    void settle()
+    {
+      while (!stack.empty())
+      {
+        const nodet *node = stack.back().first;
+        size_t i = stack.back().second;
+        if (node->is_leaf())
+        {
+          if (i < node->entries.size())
+            return;
+        }
+        else if (i < node->children.size())
+        {
+          stack.emplace_back(node->children[i].get(), 0);
+          continue;
+        }
+        stack.pop_back();
+        if (!stack.empty())
+          ++stack.back().second;
+      }
+    }
+
+    /** Nodes from the root down to the current leaf, each with the index of
+     *  the child (or entry) being visited */
+    std::vector<std::pair<const nodet *, size_t>> stack;
+  };
+
+  typedef const_iterator iterator;
+
+  const_iterator begin() const
+  {
+    return const_iterator(root.get());
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator();
+  }
+
+  size_t size() const
+  {
+    return count;
+  }
+
+  bool empty() const
+  {
+    return count == 0;
+  }
+
+  void clear()
+  {
+    root.reset();
+    count = 0;
+  }
+
+  /** @return the value of `key`, or nullptr if there is none */
+  const T *find(const Key &key) const
+  {
+    const size_t h = Hash()(key);
+    const nodet *node = root.get();
+    for (unsigned shift = 0; node; shift += bits)
+    {
+      if (node->is_leaf())
+        return node->hash == h ? find_entry(*node, key) : nullptr;
+
+      size_t slot = (h >> shift) & mask;
+      if (!node->has_child(slot))
+        return nullptr;
+      node = node->children[node->position(slot)].get();
+    }
+    return nullptr;
+  }
+
+  /** Like find(), but the value may be modified: it is first copied if it is
+   *  shared with another map. */
+  T *find_mutable(const Key &key)
+  {
+    if (!find(key))
+      return nullptr;
+
+    const size_t h = Hash()(key);
+    std::shared_ptr<nodet> *node = &root;
+    for (unsigned shift = 0;; shift += bits)
+    {
+      nodet &n = unshare(*node);
+      if (n.is_leaf())
+        return const_cast<T *>(find_entry(n, key));
+      node = &n.children[n.position((h >> shift) & mask)];
+    }
+  }
+
+  /** Inserts `value` under `key` unless the key is already present.
+   *  @return the (unshared) value stored under `key`, and whether it was
+   *  inserted */
+  std::pair<T *, bool> insert(const Key &key, const T &value)
+  {
+    if (find(key))
+      return {find_mutable(key), false};
+
+    if (!root)
+      root = std::make_shared<nodet>();
+    unshare(root);
+    count++;
+    return {insert_rec(root, 0, Hash()(key), key, value), true};
+  }
+
+  std::pair<T *, bool> insert(const value_type &value)
+  {
+    return insert(value.first, value.second);
+  }
+
+  /** @return true if `key` was present */
+  bool erase(const Key &key)
+  {
+    if (!find(key))
+      return false;
+
+    unshare(root);
+    erase_rec(*root, 0, Hash()(key), key);
+    count--;
+    return true;
+  }
+
+  /** Calls `f` on every entry of `other` that is not in a subtree shared with
+   *  this map, i.e. on a superset of the entries of `other` that are missing
+   *  from or different in this map. Neither map may be modified meanwhile. */
+  template <class F>
+  void for_each_unshared(const persistent_mapt &other, F f) const
+  {
+    unshared_rec(root.get(), other.root.get(), f);
+  }
+
+  /** @return true if both maps are the same version of one trie */
+  bool shares_root(const persistent_mapt &other) const
+  {
+    return root == other.root;
+  }
+
+protected:
+  static const T *find_entry(const nodet &leaf, const Key &key)
+  {
+    for (const value_type &e : leaf.entries)
+      if (KeyEqual()(e.first, key))
+        return &e.second;
+    return nullptr;
+  }
+
+  /** Makes `node` owned by this map alone, copying it if it is shared */
+  static nodet &unshare(std::shared_ptr<nodet> &node)
+  {
+    if (node.use_count() != 1)
+      node = std::make_shared<nodet>(*node);
+    return *node;
+  }
+
+  /** Inserts a new entry below the interior node `node`, which must already
+   *  be unshared */
+  static T *insert_rec(
+    std::shared_ptr<nodet> &node,
+    unsigned shift,
+    size_t h,
+    const Key &key,
+    const T &value)
+  {
+    nodet &n = *node;
+    const size_t slot = (h >> shift) & mask;
+    const size_t pos = n.position(slot);
+
+    if (!n.has_child(slot))
+    {
+      auto leaf = std::make_shared<nodet>();
+      leaf->hash = h;
+      leaf->entries.emplace_back(key, value);
+      n.bitmap |= uint32_t(1) << slot;
+      n.children.insert(n.children.begin() + pos, leaf);
+      return &leaf->entries.back().second;
+    }
+
+    std::shared_ptr<nodet> &child = n.children[pos];
+    if (child->is_leaf())
+    {
+      if (child->hash == h)
+      {
+        nodet &leaf = unshare(child);
+        leaf.entries.emplace_back(key, value);
+        return &leaf.entries.back().second;
+      }
+
+      // Push the leaf one level down, below a new interior node; the hashes
+      // differ, so they eventually end up in different slots
+      assert(shift + bits < sizeof(size_t) * 8);
+      auto interior = std::make_shared<nodet>();
+      interior->bitmap = uint32_t(1) << ((child->hash >> (shift + bits)) & mask);
+      interior->children.push_back(std::move(child));
+      child = std::move(interior);
+    }
+    else
+      unshare(child);
+
+    return insert_rec(child, shift + bits, h, key, value);
+  }
+
+  /** Removes an existing entry below the interior node `n`, which must
+   *  already be unshared */
+  static void erase_rec(nodet &n, unsigned shift, size_t h, const Key &key)
+  {
+    const size_t slot = (h >> shift) & mask;
+    const size_t pos = n.position(slot);
+    assert(n.has_child(slot));
+
+    std::shared_ptr<nodet> &child = n.children[pos];
+    if (child->is_leaf())
+    {
+      if (child->entries.size() == 1)
+      {
+        n.bitmap &= ~(uint32_t(1) << slot);
+        n.children.erase(n.children.begin() + pos);
+        return;
+      }
+
+      nodet &leaf = unshare(child);
+      for (auto it = leaf.entries.begin(); it != leaf.entries.end(); it++)
+        if (KeyEqual()(it->first, key))
+        {
+          leaf.entries.erase(it);
+          return;
+        }
+      assert(0 && "erasing a missing key");
+    }
+
+    nodet &sub = unshare(child);
+    erase_rec(sub, shift + bits, h, key);
+
+    // Pull a lone leaf back up, so that the trie keeps the same shape as if
+    // the erased entry had never been inserted
+    if (sub.children.empty())
+    {
+      n.bitmap &= ~(uint32_t(1) << slot);
+      n.children.erase(n.children.begin() + pos);
+    }
+    else if (sub.children.size() == 1 && sub.children.front()->is_leaf())
+      child = std::move(sub.children.front());
+  }
+
+  template <class F>
+  static void unshared_rec(const nodet *mine, const nodet *theirs, F &f)
+  {
+    if (mine == theirs || !theirs)
+      return;
+
+    if (theirs->is_leaf())
+    {
+      for (const value_type &e : theirs->entries)
+        f(e);
+      return;
+    }
+
+    // Both nodes are at the same depth, so equal slots hold equal hashes
+    const bool aligned = mine && !mine->is_leaf();
+    for (size_t slot = 0; slot <= mask; slot++)
+    {
+      if (!theirs->has_child(slot))
+        continue;
+
+      const nodet *m = aligned && mine->has_child(slot)
+                         ? mine->children[mine->position(slot)].get()
+                         : nullptr;
+      unshared_rec(m, theirs->children[theirs->position(slot)].get(), f);
+    }
+  }
+
+  /** Always an interior node, if present */
+  std::shared_ptr<nodet> root;
+  size_t count = 0;
+};
+
+#endif
@@ -0,0 +1,302 @@
+#ifndef CPROVER_SORTED_LIST_MAP_H
+#define CPROVER_SORTED_LIST_MAP_H
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Ordered map stored as a singly linked list sorted by key.
+ *
+ * Meant for the handful of named operands of an irept: the map itself is a
+ * single pointer, each entry is one small node, and a lookup walks a few
+ * nodes without any rebalancing bookkeeping. Iteration order and the results
+ * of comparisons are the same as for std::map with the same Compare.
+ *
+ * Unlike a vector, references to entries stay valid until the entry is
+ * erased, just as with std::map; irept users rely on that when they keep the
+ * irept& returned by add() while adding further operands.
+ *
+ * Only the part of the std::map interface needed by irept is provided.
+ */
+template <class Key, class T, class Compare = std::less<Key>>
+class sorted_list_mapt
+{
+public:
+  typedef Key key_type;
+  typedef T mapped_type;
+  typedef std::pair<const Key, T> value_type;
+  typedef std::size_t size_type;
+
+protected:
+  struct nodet
+  {
+    template <class... Args>
+    explicit nodet(nodet *_next, Args &&...args)
+      : next(_next), value(std::forward<Args>(args)...)
+    {
+    }
+
+    nodet *next;
+    value_type value;
+  };
+
+  template <bool is_const>
+  class iterator_baset
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename sorted_list_mapt::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef std::conditional_t<is_const, const value_type, value_type> &
+      reference;
+    typedef std::conditional_t<is_const, const value_type, value_type> *
+      pointer;
+
+    iterator_baset() = default;
+
+    /** Any iterator converts to a const_iterator */
+    template <bool c = is_const, typename = std::enable_if_t<c>>
+    iterator_baset(const iterator_baset<false> &other) : node(other.node)
+    {
+    }
+
+    reference operator*() const
+    {
+      return node->value;
+    }
+
+    pointer operator->() const
+    {
+      return &node->value;
+    }
+
+    iterator_baset &operator++()
+    {
+      node = node->next;
+      return *this;
+    }
+
+    iterator_baset operator++(int)
+    {
+      iterator_baset tmp = *this;
+      node = node->next;
+      return tmp;
+    }
+
+    bool operator==(const iterator_baset &other) const
+    {
+      return node == other.node;
+    }
+
+    bool operator!=(const iterator_baset &other) const
+    {
+      return node != other.node;
+    }
+
+  protected:
+    friend class sorted_list_mapt;
+    friend class iterator_baset<true>;
+
+    explicit iterator_baset(nodet *_node) : node(_node)
+    {
+    }
+
+    nodet *node = nullptr;
+  };
+
+public:
+  typedef iterator_baset<false> iterator;
+  typedef iterator_baset<true> const_iterator;
+
+  sorted_list_mapt() = default;
+
+  sorted_list_mapt(const sorted_list_mapt &other)
+  {
+    nodet **link = &head;
+    for (const nodet *n = other.head; n; n = n->next)
+    {
+      *link = new nodet(nullptr, n->value);
+      link = &(*link)->next;
+    }
+  }
+
+  sorted_list_mapt(sorted_list_mapt &&other) noexcept : head(other.head)
+  {
+    other.head = nullptr;
+  }
+
+  sorted_list_mapt &operator=(const sorted_list_mapt &other)
+  {
+    if (this != &other)
+    {
+      sorted_list_mapt tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  sorted_list_mapt &operator=(sorted_list_mapt &&other) noexcept
+  {
+    swap(other);
+    return *this;
+  }
+
+  ~sorted_list_mapt()
+  {
+    clear();
+  }
+
+  iterator begin()
+  {
+    return iterator(head);
+  }
+
+  iterator end()
+  {
+    return iterator();
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(head);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator();
+  }
+
+  bool empty() const
+  {
+    return head == nullptr;
+  }
+
+  /** Linear in the number of entries, like std::forward_list */
+  size_type size() const
+  {
+    size_type n = 0;
+    for (const nodet *node = head; node; node = node->next)
+      n++;
+    return n;
+  }
+
+  void clear()
+  {
+    while (head)
+    {
+      nodet *next = head->next;
+      delete head;
+      head = next;
+    }
+  }
+
+  void swap(sorted_list_mapt &other) noexcept
+  {
+    std::swap(head, other.head);
+  }
+
+  iterator find(const Key &key)
+  {
+    return iterator(find_node(key));
+  }
+
+  const_iterator find(const Key &key) const
+  {
+    return const_iterator(find_node(key));
+  }
+
+  size_type count(const Key &key) const
+  {
+    return find(key) != end();
+  }
+
+  T &operator[](const Key &key)
+  {
+    return try_emplace(key).first->second;
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args)
+  {
+    nodet **link = lower_bound(key);
+    if (*link && !Compare()(key, (*link)->value.first))
+      return {iterator(*link), false};
+
+    *link = new nodet(
+      *link,
+      std::piecewise_construct,
+      std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+    return {iterator(*link), true};
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value)
+  {
+    return try_emplace(value.first, value.second);
+  }
+
+  /** Linear, as the predecessor has to be found */
+  iterator erase(const_iterator pos)
+  {
+    nodet **link = &head;
+    while (*link != pos.node)
+      link = &(*link)->next;
+
+    nodet *next = pos.node->next;
+    delete pos.node;
+    *link = next;
+    return iterator(next);
+  }
+
+  size_type erase(const Key &key)
+  {
+    nodet **link = lower_bound(key);
+    if (!*link || Compare()(key, (*link)->value.first))
+      return 0;
+
+    nodet *next = (*link)->next;
+    delete *link;
+    *link = next;
+    return 1;
+  }
+
+  bool operator==(const sorted_list_mapt &other) const
+  {
+    const nodet *a = head, *b = other.head;
+    for (; a && b; a = a->next, b = b->next)
+      if (a->value != b->value)
+        return false;
+    return a == b;
+  }
+
+  bool operator!=(const sorted_list_mapt &other) const
+  {
+    return !(*this == other);
+  }
+
+protected:
+  nodet *find_node(const Key &key) const
+  {
+    nodet *node = head;
+    while (node && Compare()(node->value.first, key))
+      node = node->next;
+    return node && !Compare()(key, node->value.first) ? node : nullptr;
+  }
+
+  /** @return the link to the first node whose key is not less than `key` */
+  nodet **lower_bound(const Key &key)
+  {
+    nodet **link = &head;
+    while (*link && Compare()((*link)->value.first, key))
+      link = &(*link)->next;
+    return link;
+  }
+
+  nodet *head = nullptr;
+};
+
+#endif
@@ -15,72 +15,61 @@ bool string_ptrt::operator==(const string_ptrt &other) const
   return len == 0 || memcmp(s, other.s, len) == 0;
 }
 
-unsigned string_containert::get(const char *s)
+string_containert::~string_containert()
 {
-  string_ptrt string_ptr(s);
-
-  {
-    std::shared_lock lock(string_container_mutex);
-    hash_tablet::iterator it = hash_table.find(string_ptr);
+  for (size_t c = 0; c < max_chunks; c++)
+    delete[] chunks[c].load(std::memory_order_relaxed);
+}
 
-    if (it != hash_table.end())
-      return it->second;
-  }
+void string_containert::publish(unsigned no, const std::string &s)
+{
+  const size_t c = no >> chunk_bits;
+  assert(c < max_chunks && "string table is full");
 
-  std::unique_lock lock(string_container_mutex);
-  //Recheck after acquiring sole lock
-  hash_tablet::iterator it = hash_table.find(string_ptr);
-  if (it != hash_table.end())
+  slott *chunk = chunks[c].load(std::memory_order_acquire);
+  if (!chunk)
   {
-    return it->second;
+    // Shards allocate concurrently: whoever loses the race frees its chunk
+    slott *fresh = new slott[chunk_size]();
+    if (chunks[c].compare_exchange_strong(
+          chunk, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+      chunk = fresh;
+    else
+      delete[] fresh;
   }
 
-  size_t r = hash_table.size();
-
-  // these are stable
-  string_list.emplace_back(s);
-  string_ptrt result(string_list.back());
-
-  hash_table[result] = r;
-
-  // these are not
-  string_vector.push_back(&string_list.back());
-
-  return r;
+  chunk[no & (chunk_size - 1)] = &s;
 }
 
-unsigned string_containert::get(const std::string &s)
+unsigned string_containert::get(const string_ptrt &s)
 {
-  string_ptrt string_ptr(s);
+  const size_t hash = string_ptr_hash{}(s);
+  // The low bits pick the bucket within the shard's table
+  shardt &shard = shards[(hash >> 16) % num_shards];
 
   {
-    std::shared_lock lock(string_container_mutex);
-    hash_tablet::iterator it = hash_table.find(string_ptr);
+    std::shared_lock lock(shard.mutex);
+    hash_tablet::const_iterator it = shard.hash_table.find(s);
 
-    if (it != hash_table.end())
+    if (it != shard.hash_table.end())
       return it->second;
   }
 
-  std::unique_lock lock(string_container_mutex);
+  std::unique_lock lock(shard.mutex);
   //Recheck after acquiring sole lock
-  hash_tablet::iterator it = hash_table.find(string_ptr);
-  if (it != hash_table.end())
-  {
+  hash_tablet::const_iterator it = shard.hash_table.find(s);
+  if (it != shard.hash_table.end())
     return it->second;
-  }
-
-  size_t r = hash_table.size();
-
-  // these are stable
-  string_list.push_back(s);
-  string_ptrt result(string_list.back());
 
-  hash_table[result] = r;
+  const std::string &stored = shard.strings.emplace_back(s.s, s.len);
+  unsigned no = next_no.fetch_add(1, std::memory_order_relaxed);
 
-  // these are not
-  string_vector.push_back(&string_list.back());
+  // The index is only handed out after this, so whoever looks it up
+  // later finds the string in place
+  publish(no, stored);
+  shard.hash_table.emplace(string_ptrt(stored), no);
 
-  return r;
+  return no;
 }
 
 // To avoid the static initialization order fiasco, it's important to have all
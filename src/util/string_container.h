@@ -1,12 +1,15 @@
 #ifndef STRING_CONTAINER_H
 #define STRING_CONTAINER_H
 
+#include <atomic>
 #include <cassert>
-#include <list>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
 #include <string>
-#include <vector>
+#include <string_view>
 
 struct string_ptrt
 {
@@ -32,58 +35,89 @@ class string_ptr_hash
 public:
   size_t operator()(const string_ptrt s) const
   {
-    return std::hash<std::string>{}(s.s);
+    return std::hash<std::string_view>{}(std::string_view(s.s, s.len));
   }
 };
 
+/**
+ * Interns strings, handing out a dense, stable index for each distinct one.
+ *
+ * Interning goes through one of several shards, picked by the string's hash,
+ * each with its own lock; threads interning different strings rarely
+ * contend. Looking a string up by index takes no lock at all: indices map to
+ * strings through an append-only table of fixed-size chunks which are never
+ * moved once allocated.
+ */
 class string_containert
 {
 public:
   unsigned operator[](const char *s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   unsigned operator[](const std::string &s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   string_containert()
   {
     // allocate empty string -- this gets index 0
-    get("");
+    get(string_ptrt(""));
   }
-  ~string_containert() = default;
+  ~string_containert();
+
+  string_containert(const string_containert &) = delete;
+  string_containert &operator=(const string_containert &) = delete;
 
   // the pointer is guaranteed to be stable
   const char *c_str(size_t no) const
   {
-    assert(no < string_vector.size());
-    return string_vector[no]->c_str();
+    return get_string(no).c_str();
   }
 
   // the reference is guaranteed to be stable
   const std::string &get_string(size_t no) const
   {
-    std::shared_lock lock(string_container_mutex);
-    assert(no < string_vector.size());
-    return *string_vector[no];
+    assert(no < next_no.load(std::memory_order_relaxed));
+    const slott *chunk =
+      chunks[no >> chunk_bits].load(std::memory_order_acquire);
+    assert(chunk);
+    return *chunk[no & (chunk_size - 1)];
   }
 
-protected:
-  typedef std::unordered_map<string_ptrt, size_t, string_ptr_hash> hash_tablet;
-  hash_tablet hash_table;
-  mutable std::shared_mutex string_container_mutex;
-
-  unsigned get(const char *s);
-  unsigned get(const std::string &s);
+  /// Number of distinct strings interned so far
+  size_t size() const
+  {
+    return next_no.load(std::memory_order_relaxed);
+  }
 
-  typedef std::list<std::string> string_listt;
-  string_listt string_list;
+protected:
+  typedef std::unordered_map<string_ptrt, unsigned, string_ptr_hash>
+    hash_tablet;
 
-  typedef std::vector<std::string *> string_vectort;
-  string_vectort string_vector;
+  struct alignas(64) shardt
+  {
+    std::shared_mutex mutex;
+    hash_tablet hash_table;
+    // these are stable
+    std::deque<std::string> strings;
+  };
+
+  static constexpr size_t num_shards = 64;
+  shardt shards[num_shards];
+
+  typedef const std::string *slott;
+  static constexpr unsigned chunk_bits = 16;
+  static constexpr size_t chunk_size = size_t(1) << chunk_bits;
+  static constexpr size_t max_chunks = size_t(1) << (32 - chunk_bits);
+  std::unique_ptr<std::atomic<slott *>[]> chunks =
+    std::make_unique<std::atomic<slott *>[]>(max_chunks);
+  std::atomic<unsigned> next_no{0};
+
+  unsigned get(const string_ptrt &s);
+  void publish(unsigned no, const std::string &s);
 };
 
 inline string_containert &get_string_container()
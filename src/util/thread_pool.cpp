@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <thread>
+#include <util/thread_pool.h>
+
+thread_poolt::thread_poolt(size_t workers)
+  : num_workers(workers ? workers : default_num_workers())
+{
+}
+
+size_t thread_poolt::default_num_workers()
+{
+  size_t n = std::thread::hardware_concurrency();
+  return n ? n : 1;
+}
+
+void thread_poolt::submit(taskt task, size_t cost)
+{
+  pending.push_back({std::move(task), cost});
+}
+
+bool thread_poolt::pop_local(size_t worker, taskt &task)
+{
+  worker_queuet &q = *queues[worker];
+  std::lock_guard lock(q.mutex);
+  if (q.tasks.empty())
+    return false;
+  task = std::move(q.tasks.front().task);
+  q.tasks.pop_front();
+  return true;
+}
+
+bool thread_poolt::steal(size_t thief, taskt &task)
+{
+  // Start at the next worker so that thieves do not all pile on worker 0
+  for (size_t i = 1; i < queues.size(); i++)
+  {
+    worker_queuet &q = *queues[(thief + i) % queues.size()];
+    std::lock_guard lock(q.mutex);
+    if (q.tasks.empty())
+      continue;
+    task = std::move(q.tasks.back().task);
+    q.tasks.pop_back();
+    return true;
+  }
+  return false;
+}
+
+void thread_poolt::worker_loop(size_t worker)
+{
+  // No task is submitted while the batch runs, so once neither the local
+  // queue nor any victim has work left, this worker is done.
+  taskt task;
+  while (pop_local(worker, task) || steal(worker, task))
+  {
+    try
+    {
+      task();
+    }
+    catch (...)
+    {
+      std::lock_guard lock(error_mutex);
+      if (!first_error)
+        first_error = std::current_exception();
+    }
+  }
+}
+
+void thread_poolt::run()
+{
+  if (pending.empty())
+    return;
+
+  // Most expensive first: stable so equal-cost tasks keep submission order
+  std::stable_sort(
+    pending.begin(),
+    pending.end(),
+    [](const pending_taskt &a, const pending_taskt &b) {
+      return a.cost > b.cost;
+    });
+
+  const size_t active = std::min(num_workers, pending.size());
+  queues.clear();
+  for (size_t i = 0; i < active; i++)
+    queues.push_back(std::make_unique<worker_queuet>());
+  for (size_t i = 0; i < pending.size(); i++)
+    queues[i % active]->tasks.push_back(std::move(pending[i]));
+  pending.clear();
+  first_error = nullptr;
+
+  std::vector<std::thread> threads;
+  threads.reserve(active - 1);
+  for (size_t i = 1; i < active; i++)
+    threads.emplace_back(&thread_poolt::worker_loop, this, i);
+
+  // The calling thread is worker 0
+  worker_loop(0);
+
+  for (auto &t : threads)
+    t.join();
+  queues.clear();
+
+  if (first_error)
+    std::rethrow_exception(first_error);
+}
@@ -0,0 +1,73 @@
+#ifndef CPROVER_UTIL_THREAD_POOL_H
+#define CPROVER_UTIL_THREAD_POOL_H
+
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Fixed-size, work-stealing pool that executes a batch of tasks.
+ *
+ * Tasks are submitted together with an estimated cost. When the batch is
+ * run, the tasks are sorted by decreasing cost and dealt round-robin to one
+ * queue per worker, so that every worker starts with the most expensive
+ * work. Owners pop from the front of their own queue; a worker whose queue
+ * is empty steals the cheapest task from the back of another worker's
+ * queue. At most `get_num_workers()` tasks are executing at any time.
+ */
+class thread_poolt
+{
+public:
+  typedef std::function<void()> taskt;
+
+  /// @param workers number of worker threads, 0 means hardware concurrency
+  explicit thread_poolt(size_t workers = 0);
+
+  /// Queues a task for the next call to run()
+  void submit(taskt task, size_t cost = 0);
+
+  /**
+   * Executes every submitted task and blocks until all of them have finished.
+   * The calling thread takes part as one of the workers. If a task throws,
+   * the remaining tasks still run and the first exception is rethrown here.
+   */
+  void run();
+
+  size_t get_num_workers() const
+  {
+    return num_workers;
+  }
+
+  /// Number of hardware threads, or 1 if it cannot be determined
+  static size_t default_num_workers();
+
+protected:
+  struct pending_taskt
+  {
+    taskt task;
+    size_t cost;
+  };
+
+  struct worker_queuet
+  {
+    std::mutex mutex;
+    std::deque<pending_taskt> tasks;
+  };
+
+  size_t num_workers;
+  std::vector<pending_taskt> pending;
+  std::vector<std::unique_ptr<worker_queuet>> queues;
+
+  std::mutex error_mutex;
+  std::exception_ptr first_error;
+
+  bool pop_local(size_t worker, taskt &task);
+  bool steal(size_t thief, taskt &task);
+  void worker_loop(size_t worker);
+};
+
+#endif
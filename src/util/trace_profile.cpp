@@ -0,0 +1,185 @@
+#include <util/trace_profile.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+#include <util/message.h>
+
+#ifndef _WIN32
+#  include <unistd.h>
+#endif
+
+std::atomic<bool> trace_profilet::active(false);
+
+namespace
+{
+struct eventt
+{
+  /// 'X' for a span, 'C' for a counter
+  char phase;
+  const char *category;
+  std::string name;
+  uint64_t start;
+  uint64_t duration;
+  unsigned thread;
+  std::vector<std::pair<const char *, int64_t>> args;
+};
+
+struct recordert
+{
+  std::mutex mutex;
+  std::string path;
+  std::chrono::steady_clock::time_point origin;
+  std::vector<eventt> events;
+  std::atomic<unsigned> num_threads{0};
+#ifndef _WIN32
+  pid_t pid;
+#endif
+};
+
+recordert &recorder()
+{
+  static recordert r;
+  return r;
+}
+
+/// Small number for the calling thread, in order of first use
+unsigned thread_number()
+{
+  thread_local unsigned number = recorder().num_threads++;
+  return number;
+}
+
+void write_string(std::ostream &out, std::string_view s)
+{
+  out << '"';
+  for (char c : s)
+  {
+    if (c == '"' || c == '\\')
+      out << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+      out << fmt::format("\\u{:04x}", static_cast<int>(c));
+    else
+      out << c;
+  }
+  out << '"';
+}
+
+void write_event(std::ostream &out, const eventt &e)
+{
+  out << "{\"ph\":\"" << e.phase << "\",\"name\":";
+  write_string(out, e.name);
+  if (e.category)
+    out << ",\"cat\":\"" << e.category << '"';
+  out << ",\"pid\":1,\"tid\":" << e.thread << ",\"ts\":" << e.start;
+  if (e.phase == 'X')
+    out << ",\"dur\":" << e.duration;
+  out << ",\"args\":{";
+  for (size_t i = 0; i < e.args.size(); i++)
+    out << (i ? "," : "") << '"' << e.args[i].first
+        << "\":" << e.args[i].second;
+  out << "}}";
+}
+
+void write_at_exit()
+{
+  trace_profilet::write();
+}
+} // namespace
+
+void trace_profilet::start(const std::string &path)
+{
+  recordert &r = recorder();
+  r.path = path;
+  r.origin = std::chrono::steady_clock::now();
+#ifndef _WIN32
+  // Forked children must not overwrite the trace when they exit
+  r.pid = getpid();
+#endif
+  // The starting thread is the main one
+  thread_number();
+  active = true;
+  std::atexit(write_at_exit);
+}
+
+uint64_t trace_profilet::now()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+           std::chrono::steady_clock::now() - recorder().origin)
+    .count();
+}
+
+void trace_profilet::span(
+  const char *category,
+  std::string_view name,
+  uint64_t start,
+  argst args)
+{
+  if (!enabled())
+    return;
+
+  uint64_t end = now();
+  recordert &r = recorder();
+  std::lock_guard lock(r.mutex);
+  r.events.push_back(
+    {'X',
+     category,
+     std::string(name),
+     start,
+     end - start,
+     thread_number(),
+     args});
+}
+
+void trace_profilet::counter(const char *name, int64_t value)
+{
+  if (!enabled())
+    return;
+
+  uint64_t ts = now();
+  recordert &r = recorder();
+  std::lock_guard lock(r.mutex);
+  r.events.push_back(
+    {'C', nullptr, name, ts, 0, thread_number(), {{"value", value}}});
+}
+
+void trace_profilet::write()
+{
+  recordert &r = recorder();
+  std::lock_guard lock(r.mutex);
+#ifndef _WIN32
+  if (!enabled() || r.pid != getpid())
+    return;
+#else
+  if (!enabled())
+    return;
+#endif
+
+  active = false;
+  std::ofstream out(r.path);
+  if (!out)
+  {
+    log_error("Failed to write the trace profile to {}", r.path);
+    return;
+  }
+
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (unsigned i = 0; i < r.num_threads; i++)
+  {
+    out << (i ? ",\n" : "\n")
+        << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << i
+        << ",\"args\":{\"name\":";
+    write_string(out, i ? fmt::format("worker {}", i) : "esbmc");
+    out << "}}";
+  }
+  for (const eventt &e : r.events)
+  {
+    out << ",\n";
+    write_event(out, e);
+  }
+  out << "\n]}\n";
+}
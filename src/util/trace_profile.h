@@ -0,0 +1,83 @@
+#ifndef CPROVER_UTIL_TRACE_PROFILE_H
+#define CPROVER_UTIL_TRACE_PROFILE_H
+
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/**
+ * @brief Timeline of a run in the Chrome trace event format, for
+ * --trace-profile.
+ *
+ * Spans and counters are kept in memory, tagged with a small number for the
+ * thread that recorded them, and written out when the process exits. The
+ * file can be loaded in Perfetto or chrome://tracing. Until start() is called
+ * every entry point returns after testing a single flag.
+ */
+class trace_profilet
+{
+public:
+  /// Numeric arguments shown with a span
+  typedef std::initializer_list<std::pair<const char *, int64_t>> argst;
+
+  /// Starts recording; the trace is written to `path` when the process exits
+  static void start(const std::string &path);
+
+  static bool enabled()
+  {
+    return active.load(std::memory_order_relaxed);
+  }
+
+  /// @return microseconds since start()
+  static uint64_t now();
+
+  /// Records a span that began at `start`, as returned by now(), and ends now
+  static void
+  span(const char *category, std::string_view name, uint64_t start, argst args);
+
+  static void span(const char *category, std::string_view name, uint64_t start)
+  {
+    span(category, name, start, {});
+  }
+
+  /// Records the value of the counter `name` at this point in time
+  static void counter(const char *name, int64_t value);
+
+  /// Writes out what was recorded and stops recording; called at exit
+  static void write();
+
+protected:
+  static std::atomic<bool> active;
+};
+
+/// Records a span from its construction to its destruction
+class trace_spant
+{
+public:
+  trace_spant(const char *_category, std::string_view _name)
+    : category(_category),
+      start(trace_profilet::enabled() ? trace_profilet::now() : 0)
+  {
+    if (trace_profilet::enabled())
+      name = _name;
+  }
+
+  trace_spant(const trace_spant &) = delete;
+  trace_spant &operator=(const trace_spant &) = delete;
+
+  ~trace_spant()
+  {
+    if (trace_profilet::enabled())
+      trace_profilet::span(category, name, start);
+  }
+
+protected:
+  const char *category;
+  std::string name;
+  uint64_t start;
+};
+
+#endif
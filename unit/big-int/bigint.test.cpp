@@ -11,6 +11,7 @@
  \*******************************************************************/
 
 #define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include <catch2/catch.hpp>
 #include <big-int/bigint.hh>
 
@@ -331,3 +332,88 @@ TEST_CASE("arbitrary precision integers", "[core][big-int][bigint]")
     }
   }
 }
+
+// ** Storage
+// Short numbers are kept inline and longer ones on the heap
+
+SCENARIO("bigint moves between inline and heap storage", "[bigint]")
+{
+  std::vector<char> vec(100);
+  const BigInt two64 = BigInt::power2(64);
+
+  GIVEN("A number that outgrows the inline storage")
+  {
+    BigInt obj = two64 - 1;
+    obj *= obj;
+    obj *= obj;
+    REQUIRE(
+      std::string(as_string(obj, vec)) ==
+      "115792089237316195398462578067141184799968521174335529155754622898352"
+      "762650625");
+    obj /= obj;
+    REQUIRE(obj == 1);
+  }
+  GIVEN("An inline and a heap number")
+  {
+    BigInt small_obj(42);
+    BigInt large_obj = two64 * two64 * two64;
+    small_obj.swap(large_obj);
+    REQUIRE(large_obj == 42);
+    REQUIRE(small_obj == two64 * two64 * two64);
+
+    BigInt moved(std::move(large_obj));
+    REQUIRE(moved == 42);
+    moved += 1;
+    REQUIRE(moved == 43);
+
+    large_obj = small_obj;
+    small_obj = moved;
+    REQUIRE(small_obj == 43);
+    REQUIRE(large_obj / two64 == two64 * two64);
+  }
+  GIVEN("Two inline numbers")
+  {
+    BigInt a(-7), b(two64 - 1);
+    a.swap(b);
+    REQUIRE(a == two64 - 1);
+    REQUIRE(b == -7);
+    a.swap(a);
+    REQUIRE(a + 1 == two64);
+  }
+}
+
+// Hidden from the default run; use `biginttest "[benchmark]"`
+TEST_CASE("bigint small values", "[.][benchmark][bigint]")
+{
+  std::vector<BigInt> constants;
+  for (int i = -512; i < 512; i++)
+    constants.emplace_back(i * 7919);
+
+  BENCHMARK("fold constants")
+  {
+    BigInt acc;
+    for (std::size_t i = 0; i + 1 < constants.size(); i++)
+    {
+      BigInt r = constants[i] * constants[i + 1] + constants[i];
+      r /= constants[i + 1].is_zero() ? BigInt(1) : constants[i + 1];
+      acc += r;
+    }
+    return acc;
+  };
+
+  BENCHMARK("multiply intervals")
+  {
+    // The bounds of [a, b] * [c, d], as computed for integer intervals
+    std::size_t widened = 0;
+    for (std::size_t i = 0; i + 3 < constants.size(); i += 2)
+    {
+      const BigInt &a = constants[i], &b = constants[i + 1];
+      const BigInt &c = constants[i + 2], &d = constants[i + 3];
+      BigInt ac = a * c, ad = a * d, bc = b * c, bd = b * d;
+      BigInt lower = std::min({ac, ad, bc, bd});
+      BigInt upper = std::max({ac, ad, bc, bd});
+      widened += upper - lower > 1000000;
+    }
+    return widened;
+  };
+}
@@ -0,0 +1,108 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <c2goto/cprover_library_index.h>
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <util/c_types.h>
+#include <util/std_expr.h>
+#include <util/std_types.h>
+
+namespace
+{
+/// Adds a function `name` whose body refers to each of `callees`
+void add_function(
+  contextt &context,
+  const std::string &name,
+  const std::vector<std::string> &callees)
+{
+  symbolt s;
+  s.id = name;
+  s.name = name;
+  s.type = code_typet();
+  s.value = exprt("code");
+  for (const std::string &callee : callees)
+    s.value.copy_to_operands(symbol_exprt(callee, int_type()));
+  context.add(s);
+}
+
+std::vector<std::string>
+names(const cprover_library_indext &index, const std::vector<size_t> &ids)
+{
+  std::vector<std::string> result;
+  for (size_t i : ids)
+    result.push_back(index.id(i).as_string());
+  return result;
+}
+} // namespace
+
+SCENARIO("the C library index", "[core][c2goto]")
+{
+  GIVEN("A library written in the indexed format")
+  {
+    contextt context;
+    add_function(context, "f", {"g", "printf"});
+    add_function(context, "g", {"h", "g"});
+    add_function(context, "h", {});
+    add_function(context, "unused", {"h"});
+    add_function(context, "pthread_join", {});
+    add_function(context, "pthread_join_noswitch", {});
+
+    std::ostringstream out;
+    cprover_library_indext::write(out, context);
+    const std::string data = out.str();
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data.data());
+
+    cprover_library_indext index;
+    REQUIRE(!index.open(bytes, data.size()));
+
+    THEN("Every symbol is indexed")
+    {
+      REQUIRE(index.size() == 6);
+      REQUIRE(index.find("h") < index.size());
+      REQUIRE(index.find("printf") == index.size());
+    }
+
+    THEN("The closure follows the references within the library")
+    {
+      auto needed = names(index, index.closure({index.find("f")}));
+      REQUIRE(needed == std::vector<std::string>{"f", "g", "h"});
+    }
+
+    THEN("The checked variants come along with their originals")
+    {
+      auto needed = names(index, index.closure({index.find("pthread_join")}));
+      REQUIRE(
+        needed ==
+        std::vector<std::string>{"pthread_join", "pthread_join_noswitch"});
+    }
+
+    THEN("Each symbol decodes on its own")
+    {
+      for (const char *id : {"h", "g"})
+      {
+        symbolt s = index.read_symbol(index.find(id));
+        const symbolt *orig = context.find_symbol(id);
+        REQUIRE(s.id == orig->id);
+        REQUIRE(s.type == orig->type);
+        REQUIRE(s.value == orig->value);
+      }
+    }
+
+    THEN("A truncated library is rejected")
+    {
+      cprover_library_indext truncated;
+      REQUIRE(truncated.open(bytes, data.size() / 2));
+    }
+  }
+
+  GIVEN("A plain goto binary")
+  {
+    const std::string data = "GBF\0\0\0\1";
+    cprover_library_indext index;
+
+    THEN("It is rejected")
+    {
+      REQUIRE(index.open(
+        reinterpret_cast<const uint8_t *>(data.data()), data.size()));
+    }
+  }
+}
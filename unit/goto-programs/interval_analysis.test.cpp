@@ -81,6 +81,17 @@ public:
         run_test<0>(baseline);
       }
 
+      // Only keeps the states at joins, the others must be recomputed
+      SECTION("Sparse")
+      {
+        log_status("Sparse");
+        set_baseline_config();
+        interval_domaint::enable_interval_arithmetic = true;
+        ait<interval_domaint> baseline;
+        baseline.set_sparse(true);
+        run_test<0>(baseline);
+      }
+
       // Wrapped Intervals logic (see "Interval Analysis and Machine Arithmetic 2015" paper)
       SECTION("Wrapped Intervals")
       {
@@ -141,7 +152,8 @@ public:
             property.find(i_it->location.get_line().as_string());
           if (to_check != property.end())
           {
-            auto state = interval_analysis[i_it].intervals;
+            auto d = interval_analysis.abstract_state_before(i_it);
+            auto state = static_cast<interval_domaint &>(*d).intervals;
 
             for (auto property_it = to_check->second.begin();
                  property_it != to_check->second.end();
@@ -0,0 +1,94 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <goto-symex/renaming.h>
+#include <util/c_types.h>
+
+namespace
+{
+class test_level2t : public renaming::level2t
+{
+public:
+  void rename(expr2tc &expr) override
+  {
+    renaming::level2t::rename(expr);
+  }
+
+  void rename(expr2tc &lhs_symbol, unsigned count) override
+  {
+    coveredinbees(lhs_symbol, count, 0);
+  }
+
+  std::shared_ptr<renaming::level2t> clone() const override
+  {
+    return std::make_shared<test_level2t>(*this);
+  }
+};
+
+expr2tc l1_symbol(const std::string &name)
+{
+  return symbol2tc(get_uint_type(32), name, symbol2t::level1, 1, 0, 0, 0);
+}
+
+/// Assigns to `name`, returning its name record
+renaming::level2t::name_record assign(renaming::level2t &l2, const char *name)
+{
+  expr2tc sym = l1_symbol(name);
+  renaming::level2t::name_record rec(to_symbol2t(sym));
+  l2.make_assignment(sym, expr2tc(), expr2tc());
+  return rec;
+}
+
+renaming::level2t::name_sett changed_since(
+  const renaming::level2t &l2,
+  const renaming::level2t::branch_markt &mark)
+{
+  renaming::level2t::name_sett names;
+  REQUIRE(l2.changed_since(mark, names));
+  return names;
+}
+} // namespace
+
+SCENARIO("level2 tracks names assigned since a branch", "[core][goto-symex]")
+{
+  GIVEN("A level2 with some assignments")
+  {
+    test_level2t l2;
+    auto a = assign(l2, "a");
+    auto b = assign(l2, "b");
+
+    THEN("Nothing has changed at a fresh branch point")
+    {
+      auto mark = l2.mark_branch();
+      REQUIRE(changed_since(l2, mark).empty());
+    }
+
+    THEN("Only names assigned after a branch point are reported")
+    {
+      auto outer = l2.mark_branch();
+      assign(l2, "b");
+      auto inner = l2.mark_branch();
+      auto c = assign(l2, "c");
+      assign(l2, "c");
+
+      REQUIRE(changed_since(l2, inner) == renaming::level2t::name_sett{c});
+      REQUIRE(changed_since(l2, outer) == renaming::level2t::name_sett{b, c});
+      REQUIRE(l2.current_number(a) == 1);
+    }
+
+    THEN("Copies can still trace back to earlier branch points")
+    {
+      auto mark = l2.mark_branch();
+      auto copy = l2.clone();
+      auto c = assign(*copy, "c");
+      REQUIRE(changed_since(*copy, mark) == renaming::level2t::name_sett{c});
+    }
+
+    THEN("A branch point of another level2 is not found")
+    {
+      test_level2t other;
+      auto mark = other.mark_branch();
+      renaming::level2t::name_sett names;
+      REQUIRE(!l2.changed_since(mark, names));
+    }
+  }
+}
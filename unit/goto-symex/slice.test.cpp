@@ -0,0 +1,148 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <goto-symex/slice.h>
+#include <irep2/irep2_utils.h>
+#include <util/config.h>
+
+namespace
+{
+typedef symex_target_equationt::SSA_stept stept;
+
+expr2tc ssa(const std::string &name, unsigned int l2)
+{
+  return symbol2tc(get_uint_type(32), name, symbol2t::level2, 1, l2, 0, 0);
+}
+
+expr2tc num(unsigned int n)
+{
+  return constant_int2tc(get_uint_type(32), BigInt(n));
+}
+
+stept assignment(const expr2tc &lhs, const expr2tc &rhs)
+{
+  stept step;
+  step.type = goto_trace_stept::ASSIGNMENT;
+  step.guard = gen_true_expr();
+  step.lhs = lhs;
+  step.rhs = rhs;
+  return step;
+}
+
+stept check(goto_trace_stept::typet type, const expr2tc &cond)
+{
+  stept step;
+  step.type = type;
+  step.guard = gen_true_expr();
+  step.cond = cond;
+  return step;
+}
+
+/// x#1 := nondet; y#1 := x#1 + 1; z#1 := 5; assume(z#1 > 2); assert(y#1 > 0)
+symex_target_equationt::SSA_stepst make_steps()
+{
+  type2tc t = get_uint_type(32);
+  symex_target_equationt::SSA_stepst steps;
+  steps.push_back(
+    assignment(ssa("x", 1), symbol2tc(t, "nondet$symex::nondet0")));
+  steps.push_back(assignment(ssa("y", 1), add2tc(t, ssa("x", 1), num(1))));
+  steps.push_back(assignment(ssa("z", 1), num(5)));
+  steps.push_back(
+    check(goto_trace_stept::ASSUME, greaterthan2tc(ssa("z", 1), num(2))));
+  steps.push_back(
+    check(goto_trace_stept::ASSERT, greaterthan2tc(ssa("y", 1), num(0))));
+  return steps;
+}
+
+std::vector<bool> ignored(const symex_target_equationt::SSA_stepst &steps)
+{
+  std::vector<bool> result;
+  for (const stept &step : steps)
+    result.push_back(step.ignore);
+  return result;
+}
+} // namespace
+
+SCENARIO("the symex slicer", "[core][goto-symex][slice]")
+{
+  optionst options;
+
+  GIVEN("An equation with an assume on an unrelated symbol")
+  {
+    symex_target_equationt::SSA_stepst steps = make_steps();
+
+    THEN("The assume keeps its symbols unless assumes are sliced")
+    {
+      symex_slicet slicer(options);
+      slicer.run(steps);
+      REQUIRE(slicer.ignored() == 0);
+    }
+
+    THEN("Sliced assumes take their symbols with them")
+    {
+      options.set_option("slice-assumes", true);
+      symex_slicet slicer(options);
+      slicer.run(steps);
+      REQUIRE(slicer.ignored() == 2);
+      REQUIRE(
+        ignored(steps) == std::vector<bool>{false, false, true, true, false});
+    }
+
+    THEN("Symbols excluded from slicing are kept")
+    {
+      options.set_option("slice-assumes", true);
+      config.no_slice_names.insert("z");
+      symex_slicet slicer(options);
+      slicer.run(steps);
+      config.no_slice_names.clear();
+      REQUIRE(slicer.ignored() == 0);
+    }
+  }
+
+  GIVEN("Two SSA versions of one variable")
+  {
+    symex_target_equationt::SSA_stepst steps;
+    steps.push_back(assignment(ssa("w", 1), num(1)));
+    steps.push_back(assignment(ssa("w", 2), num(2)));
+    steps.push_back(
+      check(goto_trace_stept::ASSERT, greaterthan2tc(ssa("w", 2), num(0))));
+
+    THEN("Only the version that is read is kept")
+    {
+      slice_indext index(steps, options);
+      REQUIRE(index.num_symbols() == 2);
+
+      symex_slicet slicer(options);
+      slicer.run(steps);
+      REQUIRE(ignored(steps) == std::vector<bool>{true, false, false});
+    }
+  }
+
+  GIVEN("Claims sliced on a shared index")
+  {
+    contextt context;
+    namespacet ns(context);
+    symex_target_equationt eq(ns);
+    eq.SSA_steps = make_steps();
+    const slice_indext index(eq.SSA_steps, options);
+
+    THEN("Each claim is sliced on its own view")
+    {
+      symex_claim_viewt view(eq);
+      symex_slicet slicer(options, &index);
+      slicer.run(view);
+      REQUIRE(slicer.ignored() == 0);
+      REQUIRE(ignored(eq.SSA_steps) == std::vector<bool>(5, false));
+    }
+
+    THEN("Rewritten conditions are taken into account")
+    {
+      options.set_option("slice-assumes", true);
+      symex_claim_viewt view(eq);
+      view.set_cond(4, gen_true_expr());
+      symex_slicet slicer(options, &index);
+      slicer.run(view);
+      REQUIRE(slicer.ignored() == 4);
+      REQUIRE(!view.is_ignored(4));
+    }
+  }
+}
@@ -0,0 +1,72 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <goto-symex/state_fingerprint.h>
+#include <string>
+
+namespace
+{
+state_fingerprintt digest(const std::string &value)
+{
+  crypto_hash h;
+  h.ingest(value.data(), value.size());
+  h.fin();
+  return state_fingerprintt(h);
+}
+
+/// Fingerprint of a state where variable `i` holds `values[i]`
+state_fingerprintt fingerprint(const std::vector<std::string> &values)
+{
+  state_fingerprintt f;
+  for (size_t i = 0; i < values.size(); i++)
+    f += digest(values[i]).contribution(i);
+  return f;
+}
+} // namespace
+
+SCENARIO("state fingerprints", "[core][goto-symex][state-hashing]")
+{
+  GIVEN("The fingerprint of a state")
+  {
+    state_fingerprintt f = fingerprint({"a", "b", "c"});
+
+    THEN("Updating it on assignment gives that of the new state")
+    {
+      f -= digest("b").contribution(1);
+      f += digest("d").contribution(1);
+      REQUIRE(f == fingerprint({"a", "d", "c"}));
+    }
+
+    THEN("It depends on which variable holds which value")
+    {
+      REQUIRE(f != fingerprint({"b", "a", "c"}));
+      REQUIRE(fingerprint({"a", "a"}) != fingerprint({"b", "b"}));
+    }
+  }
+
+  GIVEN("A set of fingerprints")
+  {
+    state_fingerprint_sett set;
+    std::vector<state_fingerprintt> fs;
+    for (unsigned i = 0; i < 1000; i++)
+      fs.push_back(fingerprint({std::to_string(i)}));
+
+    THEN("It holds exactly what was inserted")
+    {
+      for (unsigned i = 0; i < 1000; i += 2)
+        REQUIRE(set.insert(fs[i]));
+      for (unsigned i = 0; i < 1000; i++)
+        REQUIRE(set.contains(fs[i]) == (i % 2 == 0));
+      REQUIRE(!set.insert(fs[0]));
+      REQUIRE(set.size() == 500);
+    }
+
+    THEN("The all zero fingerprint is a member like any other")
+    {
+      REQUIRE(!set.contains(state_fingerprintt()));
+      REQUIRE(set.insert(state_fingerprintt()));
+      REQUIRE(set.contains(state_fingerprintt()));
+      REQUIRE(!set.insert(state_fingerprintt()));
+      REQUIRE(set.size() == 1);
+    }
+  }
+}
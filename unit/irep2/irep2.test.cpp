@@ -115,3 +115,73 @@ SCENARIO("irep2 hashing", "[core][irep2]")
     }
   }
 }
+
+SCENARIO("irep2 hash-consing", "[core][irep2]")
+{
+  // Non-const access detaches, so only look at the nodes through these
+  const auto node = [](const expr2tc &e) { return e.get(); };
+  const auto interned = [](const expr2tc &e) { return e->interned; };
+
+  esbmct::hash_consing = true;
+
+  GIVEN("Expressions constructed in the same way")
+  {
+    expr2tc e1 = gen_testing_struct(1, 2);
+    expr2tc e2 = gen_testing_struct(1, 2);
+
+    THEN("They share one interned node")
+    {
+      REQUIRE(interned(e1));
+      REQUIRE(node(e1) == node(e2));
+      REQUIRE(node(e1)->type.get() == node(e2)->type.get());
+      test_constructed_equally(e1, e2);
+    }
+
+    THEN("Modifying one leaves the other alone")
+    {
+      to_constant_struct2t(e2).datatype_members[0] = gen_ulong(3);
+      REQUIRE(!interned(e2));
+      REQUIRE(node(e1) != node(e2));
+      REQUIRE(e1 == gen_testing_struct(1, 2));
+      test_constructed_differently(e1, e2);
+    }
+
+    THEN("A node is detached even without other owners")
+    {
+      const expr2t *before = node(e1);
+      e2 = expr2tc();
+      to_constant_struct2t(e1).datatype_members[1] = gen_ulong(3);
+      REQUIRE(node(e1) != before);
+      REQUIRE(gen_testing_struct(1, 2) != e1);
+      REQUIRE(gen_testing_struct(1, 3) == e1);
+    }
+  }
+
+  GIVEN("Expressions constructed differently")
+  {
+    THEN("Their interned nodes are distinct")
+    {
+      expr2tc e1 = gen_testing_overlap(0);
+      expr2tc e2 = gen_testing_overlap(2);
+      REQUIRE(node(e1) != node(e2));
+      test_constructed_differently(e1, e2);
+    }
+  }
+
+  GIVEN("A node built with hash-consing off")
+  {
+    esbmct::hash_consing = false;
+    expr2tc plain = gen_testing_struct(4, 5);
+    esbmct::hash_consing = true;
+
+    THEN("It still compares equal to its interned twin")
+    {
+      expr2tc twin = gen_testing_struct(4, 5);
+      REQUIRE(!interned(plain));
+      REQUIRE(interned(twin));
+      REQUIRE(plain == twin);
+    }
+  }
+
+  esbmct::hash_consing = false;
+}
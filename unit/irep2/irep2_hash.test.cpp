@@ -0,0 +1,179 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index_container.hpp>
+#include <catch2/catch.hpp>
+#include <irep2/irep2.h>
+#include <irep2/irep2_utils.h>
+#include <thread>
+#include <unordered_map>
+#include <util/numbering.h>
+
+namespace
+{
+/// A symbol plus a chain of `depth` arithmetic operations, like the right
+/// hand sides of SSA assignments
+expr2tc gen_chain(unsigned int seed, unsigned int depth)
+{
+  type2tc t = get_uint_type(32);
+  expr2tc e = symbol2tc(t, "c:@F@main@x" + std::to_string(seed));
+  for (unsigned int i = 0; i < depth; i++)
+  {
+    expr2tc c = constant_int2tc(t, BigInt(seed + i));
+    e = (i % 2) ? add2tc(t, e, c) : mul2tc(t, c, e);
+  }
+  return e;
+}
+
+std::vector<expr2tc> gen_chains(unsigned int n, unsigned int depth)
+{
+  std::vector<expr2tc> exprs;
+  exprs.reserve(n);
+  for (unsigned int i = 0; i < n; i++)
+    exprs.push_back(gen_chain(i, depth));
+  return exprs;
+}
+
+size_t hash_all(const std::vector<expr2tc> &exprs)
+{
+  size_t acc = 0;
+  for (const expr2tc &e : exprs)
+    acc ^= irep2_hash()(e);
+  return acc;
+}
+
+/// Hashes every expression from `threads` threads at once
+size_t hash_concurrently(const std::vector<expr2tc> &exprs, size_t threads)
+{
+  std::vector<size_t> result(threads);
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; t++)
+    workers.emplace_back([&, t]() { result[t] = hash_all(exprs); });
+  for (auto &w : workers)
+    w.join();
+  return result[0];
+}
+
+/// Same layout as smt_convt::smt_cachet
+struct cache_entryt
+{
+  const expr2tc val;
+  unsigned int level;
+};
+
+typedef boost::multi_index_container<
+  cache_entryt,
+  boost::multi_index::indexed_by<boost::multi_index::hashed_unique<
+    BOOST_MULTI_INDEX_MEMBER(cache_entryt, const expr2tc, val)>>>
+  cachet;
+} // namespace
+
+SCENARIO("irep2 crc memoization", "[core][irep2]")
+{
+  GIVEN("A freshly built expression")
+  {
+    const expr2tc e = gen_chain(1, 8);
+
+    THEN("Its crc is computed once and then cached")
+    {
+      REQUIRE(e->crc_val.load() == 0);
+      size_t crc = e.crc();
+      REQUIRE(crc != 0);
+      REQUIRE(e->crc_val.load() == crc);
+      REQUIRE(e.crc() == crc);
+    }
+
+    THEN("Copies keep the cached crc")
+    {
+      size_t crc = e.crc();
+      expr2tc copy = e->clone();
+      REQUIRE(static_cast<const expr2tc &>(copy)->crc_val.load() == crc);
+    }
+
+    THEN("Modifying a copy invalidates its crc only")
+    {
+      size_t crc = e.crc();
+      expr2tc copy = e;
+      to_add2t(copy).side_2 = gen_ulong(100);
+      REQUIRE(static_cast<const expr2tc &>(copy)->crc_val.load() == 0);
+      REQUIRE(copy.crc() != crc);
+      REQUIRE(e.crc() == crc);
+    }
+
+    THEN("Threads hashing it at once all agree")
+    {
+      const std::vector<expr2tc> exprs = gen_chains(64, 16);
+      const std::vector<expr2tc> twins = gen_chains(64, 16);
+      REQUIRE(hash_concurrently(exprs, 8) == hash_all(twins));
+    }
+  }
+}
+
+// Hidden from the default run; use `irep2hashtest "[benchmark]"`
+TEST_CASE("irep2_hash throughput", "[.][benchmark][irep2]")
+{
+  const unsigned int n = 1 << 12;
+
+  BENCHMARK_ADVANCED("crc of fresh expressions")
+  (Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<std::vector<expr2tc>> runs;
+    for (int i = 0; i < meter.runs(); i++)
+      runs.push_back(gen_chains(n, 8));
+    meter.measure([&](int i) { return hash_all(runs[i]); });
+  };
+
+  const std::vector<expr2tc> exprs = gen_chains(n, 8);
+  const std::vector<expr2tc> twins = gen_chains(n, 8);
+  hash_all(exprs);
+  hash_all(twins);
+
+  BENCHMARK("crc of cached expressions")
+  {
+    return hash_all(exprs);
+  };
+
+  for (size_t threads : {1, 2, 4, 8})
+    BENCHMARK(
+      "crc of shared cached expressions, " + std::to_string(threads) +
+      " threads")
+    {
+      return hash_concurrently(exprs, threads);
+    };
+
+  // vars_map and the value set's object numbering both key on irep2_hash
+  std::unordered_map<expr2tc, unsigned int, irep2_hash> vars_map;
+  hash_numbering<expr2tc, irep2_hash> numbering;
+  cachet cache;
+  for (unsigned int i = 0; i < n; i++)
+  {
+    vars_map.emplace(exprs[i], i);
+    numbering.number(exprs[i]);
+    cache.insert({exprs[i], i});
+  }
+
+  BENCHMARK("unordered_map lookup of equal expressions")
+  {
+    size_t found = 0;
+    for (const expr2tc &e : twins)
+      found += vars_map.count(e);
+    return found;
+  };
+
+  BENCHMARK("hash_numbering lookup of equal expressions")
+  {
+    unsigned int num, found = 0;
+    for (const expr2tc &e : twins)
+      found += !numbering.get_number(e, num);
+    return found;
+  };
+
+  BENCHMARK("smt_cachet-like lookup of equal expressions")
+  {
+    size_t found = 0;
+    for (const expr2tc &e : twins)
+      found += cache.count(e);
+    return found;
+  };
+}
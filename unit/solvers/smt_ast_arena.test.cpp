@@ -0,0 +1,54 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <solvers/smt/smt_ast_arena.h>
+
+SCENARIO("smt ast arenas", "[solvers][smt_ast_arena]")
+{
+  GIVEN("An arena with a pushed context")
+  {
+    smt_ast_arenat arena;
+    void *before = arena.allocate(24, 8);
+    arena.push();
+
+    THEN("Allocations are aligned and do not overlap")
+    {
+      std::set<uintptr_t> starts;
+      for (size_t i = 1; i < 5000; i++)
+      {
+        size_t align = size_t(1) << (i % 5);
+        auto *p = static_cast<char *>(arena.allocate(i % 200 + 1, align));
+        REQUIRE(reinterpret_cast<uintptr_t>(p) % align == 0);
+        memset(p, 0, i % 200 + 1);
+        REQUIRE(starts.insert(reinterpret_cast<uintptr_t>(p)).second);
+      }
+      REQUIRE(!starts.count(reinterpret_cast<uintptr_t>(before)));
+    }
+
+    THEN("Popping releases the context for reuse")
+    {
+      void *first = arena.allocate(24, 8);
+      for (unsigned i = 0; i < 100000; i++)
+        arena.allocate(48, 8);
+      size_t capacity = arena.capacity();
+
+      arena.pop();
+      arena.push();
+      REQUIRE(arena.allocate(24, 8) == first);
+      for (unsigned i = 0; i < 100000; i++)
+        arena.allocate(48, 8);
+      REQUIRE(arena.capacity() == capacity);
+    }
+
+    THEN("Objects larger than a chunk get a chunk of their own")
+    {
+      auto *big = static_cast<char *>(arena.allocate(1 << 20, 16));
+      memset(big, 1, 1 << 20);
+      REQUIRE(arena.allocate(8, 8) != nullptr);
+      arena.pop();
+      REQUIRE(arena.allocate(24, 8) != before);
+    }
+  }
+}
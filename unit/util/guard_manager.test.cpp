@@ -0,0 +1,73 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <irep2/irep2_utils.h>
+#include <util/guard_manager.h>
+
+namespace
+{
+expr2tc guard(const std::string &name)
+{
+  return symbol2tc(get_bool_type(), name);
+}
+} // namespace
+
+TEST_CASE("guard manager", "[core][utils][guard_manager]")
+{
+  guard_managert m;
+  typedef guard_managert::edget edget;
+  const edget a = m.from_expr(guard("a"));
+  const edget b = m.from_expr(guard("b"));
+  const edget c = m.from_expr(guard("c"));
+
+  SECTION("structurally equal guards are shared")
+  {
+    edget ab = m.conjunction(a, b);
+    REQUIRE(m.conjunction(b, a) == ab);
+    REQUIRE(m.from_expr(and2tc(guard("a"), guard("b"))) == ab);
+    const expr2tc e1 = m.as_expr(ab), e2 = m.as_expr(m.conjunction(b, a));
+    REQUIRE(e1.get() == e2.get());
+    REQUIRE(m.size() == 5);
+  }
+
+  SECTION("trivial conjunctions and disjunctions are simplified")
+  {
+    REQUIRE(m.conjunction(a, m.negation(a)) == guard_managert::false_edge);
+    REQUIRE(m.disjunction(a, m.negation(a)) == guard_managert::true_edge);
+    REQUIRE(m.conjunction(a, guard_managert::true_edge) == a);
+    REQUIRE(m.conjunction(a, a) == a);
+    REQUIRE(m.from_expr(not2tc(not2tc(guard("a")))) == a);
+  }
+
+  SECTION("conjunctions look into their operands")
+  {
+    edget ab = m.conjunction(a, b);
+    REQUIRE(m.conjunction(ab, m.negation(a)) == guard_managert::false_edge);
+    REQUIRE(m.conjunction(ab, b) == ab);
+    REQUIRE(m.conjunction(m.negation(ab), m.negation(b)) == m.negation(b));
+    REQUIRE(
+      m.conjunction(m.negation(ab), a) == m.conjunction(a, m.negation(b)));
+  }
+
+  SECTION("paths that split after a common prefix are joined")
+  {
+    // (a && b) || (a && !b) is a
+    edget left = m.conjunction(a, b);
+    edget right = m.conjunction(a, m.negation(b));
+    REQUIRE(m.disjunction(left, right) == a);
+
+    // (a && b) || (a && c) is a && (b || c)
+    right = m.conjunction(a, c);
+    edget joined = m.disjunction(left, right);
+    REQUIRE(joined == m.conjunction(a, m.disjunction(b, c)));
+    REQUIRE(
+      m.as_expr(joined) ==
+      and2tc(guard("a"), or2tc(guard("b"), guard("c"))));
+  }
+
+  SECTION("expressions are rebuilt from the graph")
+  {
+    expr2tc e = or2tc(guard("a"), not2tc(guard("c")));
+    REQUIRE(m.as_expr(m.from_expr(e)) == e);
+    REQUIRE(m.as_expr(guard_managert::false_edge) == gen_false_expr());
+  }
+}
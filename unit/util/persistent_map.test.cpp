@@ -0,0 +1,182 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <util/persistent_map.h>
+
+namespace
+{
+/// Sends every key to one of a few full hashes, to exercise the leaves that
+/// hold several entries
+struct colliding_hash
+{
+  size_t operator()(unsigned k) const
+  {
+    return k % 7;
+  }
+};
+
+typedef persistent_mapt<unsigned, std::string> mapt;
+typedef persistent_mapt<unsigned, std::string, colliding_hash> colliding_mapt;
+
+template <class M>
+std::map<unsigned, std::string> contents(const M &m)
+{
+  std::map<unsigned, std::string> result;
+  for (const auto &e : m)
+    REQUIRE(result.emplace(e.first, e.second).second);
+  return result;
+}
+
+template <class M>
+std::map<unsigned, std::string> fill(M &m, unsigned n, unsigned stride)
+{
+  std::map<unsigned, std::string> expected;
+  for (unsigned i = 0; i < n; i++)
+  {
+    unsigned k = i * stride;
+    REQUIRE(m.insert(k, std::to_string(k)).second);
+    expected.emplace(k, std::to_string(k));
+  }
+  return expected;
+}
+
+std::map<unsigned, std::string>
+unshared(const mapt &mine, const mapt &theirs)
+{
+  std::map<unsigned, std::string> result;
+  mine.for_each_unshared(
+    theirs, [&result](const mapt::value_type &e) { result.insert(e); });
+  return result;
+}
+} // namespace
+
+TEMPLATE_TEST_CASE(
+  "persistent map operations",
+  "[core][utils][persistent_map]",
+  mapt,
+  colliding_mapt)
+{
+  TestType m;
+  REQUIRE(m.empty());
+  REQUIRE(m.begin() == m.end());
+  REQUIRE(m.find(1) == nullptr);
+
+  // A large stride makes keys differ only in high bits, i.e. deep in the trie
+  const unsigned stride = GENERATE(1u, 3u, 1u << 20);
+  auto expected = fill(m, 1000, stride);
+  REQUIRE(m.size() == expected.size());
+  REQUIRE(contents(m) == expected);
+
+  THEN("Present keys are found and absent ones are not")
+  {
+    REQUIRE(*m.find(10 * stride) == std::to_string(10 * stride));
+    REQUIRE(m.find(1000 * stride) == nullptr);
+    REQUIRE(m.find_mutable(1000 * stride) == nullptr);
+  }
+
+  THEN("Inserting an existing key keeps its value")
+  {
+    auto r = m.insert(5 * stride, "other");
+    REQUIRE(!r.second);
+    REQUIRE(*r.first == std::to_string(5 * stride));
+    REQUIRE(m.size() == expected.size());
+  }
+
+  THEN("Erasing removes exactly one key")
+  {
+    for (unsigned i = 0; i < 1000; i += 2)
+    {
+      REQUIRE(m.erase(i * stride));
+      expected.erase(i * stride);
+    }
+    REQUIRE(!m.erase(0));
+    REQUIRE(m.size() == expected.size());
+    REQUIRE(contents(m) == expected);
+
+    for (unsigned i = 1; i < 1000; i += 2)
+      REQUIRE(m.erase(i * stride));
+    REQUIRE(m.empty());
+    REQUIRE(m.begin() == m.end());
+  }
+}
+
+SCENARIO("persistent maps share structure", "[core][utils][persistent_map]")
+{
+  GIVEN("A map and a copy of it")
+  {
+    mapt m;
+    const auto expected = fill(m, 1000, 1);
+    mapt copy = m;
+
+    THEN("They share everything")
+    {
+      REQUIRE(copy.shares_root(m));
+      REQUIRE(unshared(m, copy).empty());
+    }
+
+    THEN("Modifying the copy leaves the original alone")
+    {
+      *copy.find_mutable(1) = "one";
+      copy.insert(5000, "new");
+      copy.erase(2);
+
+      REQUIRE(contents(m) == expected);
+      REQUIRE(*copy.find(1) == "one");
+      REQUIRE(*copy.find(5000) == "new");
+      REQUIRE(copy.find(2) == nullptr);
+      REQUIRE(copy.size() == m.size());
+    }
+
+    THEN("Only the modified entries are unshared")
+    {
+      *copy.find_mutable(1) = "one";
+      copy.insert(5000, "new");
+
+      auto diff = unshared(m, copy);
+      REQUIRE(diff.count(1));
+      REQUIRE(diff.count(5000));
+      // Entries next to the modified ones in the trie may come along, but not
+      // the bulk of the map
+      REQUIRE(diff.size() < 10);
+    }
+  }
+}
+
+// Hidden from the default run; use `persistentmaptest "[benchmark]"`
+TEST_CASE("persistent map copies", "[.][benchmark][persistent_map]")
+{
+  const unsigned n = 1 << 14;
+  std::unordered_map<unsigned, std::string> hash_map;
+  mapt m;
+  for (unsigned i = 0; i < n; i++)
+  {
+    hash_map.emplace(i, std::to_string(i));
+    m.insert(i, std::to_string(i));
+  }
+
+  BENCHMARK("unordered_map copy and modify one entry")
+  {
+    auto copy = hash_map;
+    copy[n / 2] = "modified";
+    return copy.size();
+  };
+
+  BENCHMARK("persistent_mapt copy and modify one entry")
+  {
+    auto copy = m;
+    *copy.find_mutable(n / 2) = "modified";
+    return copy.size();
+  };
+
+  mapt modified = m;
+  for (unsigned i = 0; i < n; i += n / 16)
+    *modified.find_mutable(i) = "modified";
+
+  BENCHMARK("persistent_mapt visit entries differing from a copy")
+  {
+    return unshared(m, modified).size();
+  };
+}
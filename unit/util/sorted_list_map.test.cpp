@@ -0,0 +1,113 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+#include <map>
+#include <string>
+#include <util/irep.h>
+#include <util/sorted_list_map.h>
+
+namespace
+{
+typedef sorted_list_mapt<int, std::string> mapt;
+
+std::map<int, std::string> contents(const mapt &m)
+{
+  return std::map<int, std::string>(m.begin(), m.end());
+}
+
+/// An irept with the named operands of a typical frontend expression
+irept make_expr(unsigned i)
+{
+  irept e("symbol");
+  e.set("identifier", "c:@F@main@x" + std::to_string(i));
+  e.set("type", irept("signedbv"));
+  e.add("type").set("width", 32);
+  e.set("#lvalue", true);
+  e.set("#location", irept("location"));
+  return e;
+}
+} // namespace
+
+SCENARIO("sorted list maps", "[core][utils][sorted_list_map]")
+{
+  GIVEN("A map filled out of order")
+  {
+    mapt m;
+    std::map<int, std::string> expected;
+    for (int k : {5, 1, 9, 3, 7})
+    {
+      m[k] = std::to_string(k);
+      expected[k] = std::to_string(k);
+    }
+
+    THEN("It iterates in key order")
+    {
+      REQUIRE(m.size() == 5);
+      REQUIRE(contents(m) == expected);
+      REQUIRE(m.begin()->first == 1);
+    }
+
+    THEN("Lookups find present keys only")
+    {
+      REQUIRE(m.find(7)->second == "7");
+      REQUIRE(m.find(4) == m.end());
+      REQUIRE(m.count(9) == 1);
+      REQUIRE(m.count(10) == 0);
+    }
+
+    THEN("References survive insertions")
+    {
+      std::string &three = m[3];
+      for (int k = 10; k < 100; k++)
+        m[k];
+      m[2] = "2";
+      REQUIRE(&three == &m[3]);
+    }
+
+    THEN("Erasing keeps the others")
+    {
+      REQUIRE(m.erase(1) == 1);
+      REQUIRE(m.erase(1) == 0);
+      m.erase(m.find(9));
+      expected.erase(1);
+      expected.erase(9);
+      REQUIRE(contents(m) == expected);
+    }
+
+    THEN("Copies are equal and independent")
+    {
+      mapt copy = m;
+      REQUIRE(copy == m);
+      copy[5] = "five";
+      REQUIRE(copy != m);
+      REQUIRE(m[5] == "5");
+    }
+  }
+}
+
+// Hidden from the default run; use `sortedlistmaptest "[benchmark]"`
+TEST_CASE("irept named operands", "[.][benchmark][sorted_list_map]")
+{
+  const unsigned n = 1 << 12;
+
+  BENCHMARK("build expressions")
+  {
+    std::vector<irept> exprs;
+    for (unsigned i = 0; i < n; i++)
+      exprs.push_back(make_expr(i));
+    return exprs.size();
+  };
+
+  std::vector<irept> exprs;
+  for (unsigned i = 0; i < n; i++)
+    exprs.push_back(make_expr(i));
+
+  BENCHMARK("look up named operands")
+  {
+    size_t found = 0;
+    for (const irept &e : exprs)
+      found += e.get_bool("#lvalue") + !e.find("type").is_nil() +
+               !e.get("identifier").empty();
+    return found;
+  };
+}
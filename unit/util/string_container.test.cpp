@@ -0,0 +1,127 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+#include <util/string_container.h>
+
+namespace
+{
+std::vector<std::string> make_names(size_t n)
+{
+  std::vector<std::string> names;
+  names.reserve(n);
+  for (size_t i = 0; i < n; i++)
+    names.push_back("c:@F@main@symbol_" + std::to_string(i));
+  return names;
+}
+
+/// Interns every name from `threads` threads at once, each starting at a
+/// different offset, and returns the index each thread got for each name
+std::vector<std::vector<unsigned>> intern_concurrently(
+  string_containert &container,
+  const std::vector<std::string> &names,
+  size_t threads)
+{
+  std::vector<std::vector<unsigned>> result(
+    threads, std::vector<unsigned>(names.size()));
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; t++)
+    workers.emplace_back([&, t]() {
+      const size_t offset = t * names.size() / threads;
+      for (size_t i = 0; i < names.size(); i++)
+      {
+        size_t n = (i + offset) % names.size();
+        result[t][n] = container[names[n]];
+      }
+    });
+  for (auto &w : workers)
+    w.join();
+  return result;
+}
+} // namespace
+
+SCENARIO("strings are interned", "[core][utils][string_container]")
+{
+  GIVEN("An empty container")
+  {
+    string_containert container;
+
+    THEN("The empty string has index 0")
+    {
+      REQUIRE(container[""] == 0);
+      REQUIRE(container.get_string(0).empty());
+    }
+
+    THEN("Equal strings share an index and different ones do not")
+    {
+      unsigned a = container["foo"];
+      unsigned b = container[std::string("bar")];
+      REQUIRE(a != b);
+      REQUIRE(container[std::string("foo")] == a);
+      REQUIRE(container["bar"] == b);
+      REQUIRE(container.get_string(a) == "foo");
+      REQUIRE(std::string(container.c_str(b)) == "bar");
+    }
+
+    THEN("Strings with embedded NULs are told apart")
+    {
+      unsigned a = container[std::string("a\0b", 3)];
+      unsigned b = container[std::string("a\0c", 3)];
+      REQUIRE(a != b);
+      REQUIRE(container.get_string(a) == std::string("a\0b", 3));
+    }
+
+    THEN("Strings stay in place while many more are interned")
+    {
+      const std::string &first = container.get_string(container["first"]);
+      const auto names = make_names(200000);
+      for (const auto &name : names)
+        container[name];
+      REQUIRE(first == "first");
+      REQUIRE(container.size() == names.size() + 2);
+      REQUIRE(container.get_string(container[names.back()]) == names.back());
+    }
+  }
+
+  GIVEN("Several threads interning the same strings")
+  {
+    string_containert container;
+    const auto names = make_names(20000);
+    const auto result = intern_concurrently(container, names, 8);
+
+    THEN("Every thread gets the same, distinct index for each string")
+    {
+      REQUIRE(container.size() == names.size() + 1);
+      for (size_t n = 0; n < names.size(); n++)
+      {
+        for (const auto &r : result)
+          REQUIRE(r[n] == result[0][n]);
+        REQUIRE(container.get_string(result[0][n]) == names[n]);
+      }
+    }
+  }
+}
+
+// Hidden from the default run; use `stringcontainertest "[benchmark]"`
+TEST_CASE("string interning throughput", "[.][benchmark][string_container]")
+{
+  const auto names = make_names(1 << 14);
+
+  for (size_t threads : {1, 2, 4, 8, 16, 32, 64})
+  {
+    BENCHMARK("intern new strings, " + std::to_string(threads) + " threads")
+    {
+      string_containert container;
+      return intern_concurrently(container, names, threads).size();
+    };
+
+    string_containert warm;
+    intern_concurrently(warm, names, 1);
+    BENCHMARK("look up interned strings, " + std::to_string(threads) + " threads")
+    {
+      return intern_concurrently(warm, names, threads).size();
+    };
+  }
+}
@@ -0,0 +1,73 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <util/thread_pool.h>
+
+SCENARIO("thread pool runs every task", "[core][utils][thread_pool]")
+{
+  GIVEN("More tasks than workers")
+  {
+    thread_poolt pool(3);
+    std::atomic<size_t> sum{0};
+    for (size_t i = 1; i <= 100; i++)
+      pool.submit([&sum, i]() { sum += i; }, i % 7);
+
+    THEN("All of them are executed exactly once")
+    {
+      pool.run();
+      REQUIRE(sum == 5050);
+    }
+  }
+
+  GIVEN("A bounded pool")
+  {
+    thread_poolt pool(2);
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+    for (size_t i = 0; i < 32; i++)
+      pool.submit([&running, &peak]() {
+        int now = ++running;
+        int old = peak;
+        while (now > old && !peak.compare_exchange_weak(old, now))
+          ;
+        --running;
+      });
+
+    THEN("No more tasks than workers run concurrently")
+    {
+      pool.run();
+      REQUIRE(peak <= 2);
+    }
+  }
+
+  GIVEN("A single worker")
+  {
+    thread_poolt pool(1);
+    std::vector<size_t> order;
+    for (size_t cost : {3, 10, 1, 7})
+      pool.submit([&order, cost]() { order.push_back(cost); }, cost);
+
+    THEN("Tasks run in decreasing cost order")
+    {
+      pool.run();
+      REQUIRE(order == std::vector<size_t>{10, 7, 3, 1});
+    }
+  }
+
+  GIVEN("A task that throws")
+  {
+    thread_poolt pool(2);
+    std::atomic<int> done{0};
+    pool.submit([]() { throw std::runtime_error("boom"); }, 5);
+    for (int i = 0; i < 4; i++)
+      pool.submit([&done]() { ++done; });
+
+    THEN("The other tasks still run and the exception is rethrown")
+    {
+      REQUIRE_THROWS_AS(pool.run(), std::runtime_error);
+      REQUIRE(done == 4);
+    }
+  }
+}
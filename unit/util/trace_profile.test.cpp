@@ -0,0 +1,59 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <set>
+#include <thread>
+#include <util/trace_profile.h>
+
+TEST_CASE("trace profiles", "[core][utils][trace_profile]")
+{
+  // Nothing is recorded, or written, until a profile is requested
+  REQUIRE(!trace_profilet::enabled());
+  trace_profilet::counter("ignored", 1);
+
+  const std::string path =
+    (boost::filesystem::temp_directory_path() /
+     boost::filesystem::unique_path("esbmc-trace-%%%%-%%%%.json"))
+      .string();
+  trace_profilet::start(path);
+  REQUIRE(trace_profilet::enabled());
+
+  {
+    trace_spant outer("test", "outer \"span\"");
+    std::thread([]() { trace_spant inner("test", "worker span"); }).join();
+    trace_profilet::counter("steps", 42);
+  }
+  trace_profilet::write();
+
+  nlohmann::json trace;
+  std::ifstream(path) >> trace;
+  boost::filesystem::remove(path);
+
+  std::set<unsigned> span_threads;
+  unsigned thread_names = 0;
+  for (const nlohmann::json &e : trace["traceEvents"])
+  {
+    REQUIRE(e["name"] != "ignored");
+    if (e["ph"] == "M")
+      thread_names++;
+    else if (e["ph"] == "X")
+    {
+      span_threads.insert(e["tid"].get<unsigned>());
+      REQUIRE(e.contains("dur"));
+      if (e["name"] == "outer \"span\"")
+        REQUIRE(e["tid"] == 0);
+    }
+    else
+    {
+      REQUIRE(e["ph"] == "C");
+      REQUIRE(e["name"] == "steps");
+      REQUIRE(e["args"]["value"] == 42);
+    }
+  }
+
+  // The spans of each thread are told apart and each thread is named
+  REQUIRE(span_threads == std::set<unsigned>{0, 1});
+  REQUIRE(thread_names == 2);
+}